@@ -1,221 +1,5359 @@
-#include <iostream>
-#include <vector>
-#include <algorithm>
-#include <cmath>
-#include <chrono>
-#include <fstream>
-#include <map>
-
-// Point structure
-struct Point {
-    double x, y;
-
-    bool operator==(const Point& other) const {
-        return x == other.x && y == other.y;
-    }
-    // Add a less-than operator to use Point as a map key
-    bool operator<(const Point& other) const {
-        if (x < other.x) return true;
-        if (x > other.x) return false;
-        return y < other.y;
-    }
-};
-
-// Edge structure
-struct Edge {
-    Point p1, p2;
-
-    bool operator==(const Edge& other) const {
-        return (p1 == other.p1 && p2 == other.p2) || (p1 == other.p2 && p2 == other.p1);
-    }
-};
-
-// Triangle structure
-struct Triangle {
-    Point a, b, c;
-};
-
-// Function to check if point p is inside the circumcircle of triangle t
-bool inCircumcircle(const Point& p, const Triangle& t) {
-    double ax = t.a.x - p.x;
-    double ay = t.a.y - p.y;
-    double bx = t.b.x - p.x;
-    double by = t.b.y - p.y;
-    double cx = t.c.x - p.x;
-    double cy = t.c.y - p.y;
-
-    double det = (ax * ax + ay * ay) * (bx * cy - cx * by) -
-                 (bx * bx + by * by) * (ax * cy - cx * ay) +
-                 (cx * cx + cy * cy) * (ax * by - bx * ay);
-
-    // For a counter-clockwise triangle, the point is inside if det > 0
-    // We need to ensure triangles are consistently oriented (e.g., CCW)
-    // but for Bowyer-Watson, the sign consistency is what matters.
-    return det > 1e-9;
-}
-
-// Delaunay triangulation function
-std::vector<Triangle> delaunayTriangulation(std::vector<Point>& points) {
-    std::vector<Triangle> triangles;
-
-    // Determine the bounds of the points
-    double minX = points[0].x;
-    double minY = points[0].y;
-    double maxX = minX;
-    double maxY = minY;
-    for (const auto& p : points) {
-        minX = std::min(minX, p.x);
-        minY = std::min(minY, p.y);
-        maxX = std::max(maxX, p.x);
-        maxY = std::max(maxY, p.y);
-    }
-    double dx = maxX - minX;
-    double dy = maxY - minY;
-    double deltaMax = std::max(dx, dy);
-    double midX = (minX + maxX) / 2.0;
-    double midY = (minY + maxY) / 2.0;
-
-    // Create a super triangle that encompasses all points
-    Point p1 = {midX - 20 * deltaMax, midY - deltaMax};
-    Point p2 = {midX + 20 * deltaMax, midY - deltaMax};
-    Point p3 = {midX, midY + 20 * deltaMax};
-    Triangle superTriangle = {p1, p2, p3};
-    triangles.push_back(superTriangle);
-
-    for (const auto& point : points) {
-        std::vector<Triangle> badTriangles;
-        std::vector<Edge> polygon;
-
-        // Find triangles whose circumcircle contains the point
-        for (const auto& triangle : triangles) {
-            if (inCircumcircle(point, triangle)) {
-                badTriangles.push_back(triangle);
-                polygon.push_back({triangle.a, triangle.b});
-                polygon.push_back({triangle.b, triangle.c});
-                polygon.push_back({triangle.c, triangle.a});
-            }
-        }
-
-        // Remove bad triangles from the triangulation
-        triangles.erase(std::remove_if(triangles.begin(), triangles.end(),
-            [&](const Triangle& t) {
-                for (const auto& bad : badTriangles) {
-                    if (t.a == bad.a && t.b == bad.b && t.c == bad.c) {
-                        return true;
-                    }
-                }
-                return false;
-            }), triangles.end());
-
-        // Find the unique edges of the polygonal hole
-        std::vector<Edge> uniqueEdges;
-        for (size_t i = 0; i < polygon.size(); ++i) {
-            bool isUnique = true;
-            for (size_t j = 0; j < polygon.size(); ++j) {
-                if (i != j && polygon[i] == polygon[j]) {
-                    isUnique = false;
-                    break;
-                }
-            }
-            if (isUnique) {
-                uniqueEdges.push_back(polygon[i]);
-            }
-        }
-
-        // Create new triangles from the point to the unique edges
-        for (const auto& edge : uniqueEdges) {
-            triangles.push_back({edge.p1, edge.p2, point});
-        }
-    }
-
-    // Remove triangles that share a vertex with the super triangle
-    triangles.erase(std::remove_if(triangles.begin(), triangles.end(),
-        [&](const Triangle& t) {
-            return t.a == superTriangle.a || t.b == superTriangle.a || t.c == superTriangle.a ||
-                   t.a == superTriangle.b || t.b == superTriangle.b || t.c == superTriangle.b ||
-                   t.a == superTriangle.c || t.b == superTriangle.c || t.c == superTriangle.c;
-        }), triangles.end());
-
-    return triangles;
-}
-
-// Function to export triangles to a VTK file
-void exportToVTK(const std::vector<Triangle>& triangles, const std::string& filename) {
-    std::ofstream vtkFile(filename);
-    if (!vtkFile.is_open()) {
-        std::cerr << "Error: Could not open file " << filename << std::endl;
-        return;
-    }
-
-    vtkFile << "# vtk DataFile Version 3.0\n";
-    vtkFile << "Delaunay Triangulation\n";
-    vtkFile << "ASCII\n";
-    vtkFile << "DATASET UNSTRUCTURED_GRID\n";
-
-    // Collect unique points and map them to an index
-    std::map<Point, int> pointMap;
-    int pointIndex = 0;
-    for (const auto& tri : triangles) {
-        if (pointMap.find(tri.a) == pointMap.end()) pointMap[tri.a] = pointIndex++;
-        if (pointMap.find(tri.b) == pointMap.end()) pointMap[tri.b] = pointIndex++;
-        if (pointMap.find(tri.c) == pointMap.end()) pointMap[tri.c] = pointIndex++;
-    }
-
-    // Write unique points
-    vtkFile << "POINTS " << pointMap.size() << " float\n";
-    std::vector<Point> uniquePoints(pointMap.size());
-    for(const auto& pair : pointMap) {
-        uniquePoints[pair.second] = pair.first;
-    }
-    for(const auto& p : uniquePoints) {
-        vtkFile << p.x << " " << p.y << " 0.0\n";
-    }
-
-    // Write triangles (cells)
-    vtkFile << "CELLS " << triangles.size() << " " << triangles.size() * 4 << "\n";
-    for (const auto& tri : triangles) {
-        vtkFile << "3 " << pointMap[tri.a] << " " << pointMap[tri.b] << " " << pointMap[tri.c] << "\n";
-    }
-
-    // Write cell types
-    vtkFile << "CELL_TYPES " << triangles.size() << "\n";
-    for (size_t i = 0; i < triangles.size(); ++i) {
-        vtkFile << "5\n"; // VTK_TRIANGLE
-    }
-
-    vtkFile.close();
-    std::cout << "Exported to " << filename << std::endl;
-}
-
-int main() {
-    std::vector<Point> points = {
-        {0.0, 0.0}, {0.7, 1.4}, {2.7, 2.7}, {6.0, 3.8},
-        {10.5, 4.8}, {16.1, 5.5}, {22.7, 5.9}, {29.9, 6.0},
-        {37.7, 5.9}, {45.9, 5.5}, {54.1, 5.0}, {62.3, 4.4},
-        {70.1, 3.6}, {77.3, 2.9}, {83.9, 2.1}, {89.5, 1.4},
-        {94.0, 0.8}, {97.3, 0.4}, {99.3, 0.1}, {0.7, -1.4},
-        {2.7, -2.7}, {6.0, -3.8}, {10.5, -4.8}, {16.1, -5.5},
-        {22.7, -5.9}, {29.9, -6.0}, {37.7, -5.9}, {45.9, -5.5},
-        {54.1, -5.0}, {62.3, -4.4}, {70.1, -3.6}, {77.3, -2.9},
-        {83.9, -2.1}, {89.5, -1.4}, {94.0, -0.8}, {97.3, -0.4},
-        {99.3, -0.1}, {0.7, 0.0}, {2.7, 0.0}, {6.0, 0.0},
-        {10.5, 0.0}, {16.1, 0.0}, {22.7, 0.0}, {29.9, 0.0},
-        {37.7, 0.0}, {45.9, 0.0}, {54.1, 0.0}, {62.3, 0.0},
-        {70.1, 0.0}, {77.3, 0.0}, {83.9, 0.0}, {89.5, 0.0},
-        {94.0, 0.0}, {97.3, 0.0}, {99.3, 0.0}, {100.0, 0.0}
-    };   
-
-    auto start = std::chrono::high_resolution_clock::now();
-    std::vector<Triangle> triangles = delaunayTriangulation(points);
-    auto end = std::chrono::high_resolution_clock::now();
-
-    std::chrono::duration<double> duration = end - start;
-    std::cout << "Time taken for triangulation: " << duration.count() << " seconds." << std::endl;
-    std::cout << "Generated " << triangles.size() << " triangles." << std::endl;
-
-    // Export triangles to VTK file
-    exportToVTK(triangles, "triangulation.vtk");
-
-    return 0;
-}
-
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <cctype>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <climits>
+#include <limits>
+#include <cerrno>
+#include <type_traits>
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <dirent.h>
+#include <poll.h>
+#include <signal.h>
+#endif
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/wait.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Point structure over a coordinate type; everything outside the core works on Point (double)
+template <typename Scalar>
+struct BasicPoint {
+    Scalar x, y;
+
+    bool operator==(const BasicPoint& other) const {
+        return x == other.x && y == other.y;
+    }
+    // Add a less-than operator to use Point as a map key
+    bool operator<(const BasicPoint& other) const {
+        if (x < other.x) return true;
+        if (x > other.x) return false;
+        return y < other.y;
+    }
+};
+
+typedef BasicPoint<double> Point;
+
+// Non-owning view of a contiguous point array (a std::vector or a memory-mapped file)
+template <typename Scalar>
+struct BasicPointSpan {
+    const BasicPoint<Scalar>* points;
+    size_t count;
+
+    BasicPointSpan(const std::vector<BasicPoint<Scalar>>& v) : points(v.data()), count(v.size()) {}
+    BasicPointSpan(const BasicPoint<Scalar>* data, size_t size) : points(data), count(size) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const BasicPoint<Scalar>& operator[](size_t i) const { return points[i]; }
+    const BasicPoint<Scalar>* begin() const { return points; }
+    const BasicPoint<Scalar>* end() const { return points + count; }
+};
+
+typedef BasicPointSpan<double> PointSpan;
+
+// Edge structure
+struct Edge {
+    Point p1, p2;
+
+    bool operator==(const Edge& other) const {
+        return (p1 == other.p1 && p2 == other.p2) || (p1 == other.p2 && p2 == other.p1);
+    }
+};
+
+// Triangle structure
+struct Triangle {
+    Point a, b, c;
+};
+
+// Indexed triangle structure (vertex indices into the input point array); int everywhere but the core
+template <typename Index>
+struct BasicIndexedTriangle {
+    Index a, b, c;
+};
+
+typedef BasicIndexedTriangle<int> IndexedTriangle;
+
+// Indexed edge structure
+template <typename Index>
+struct BasicIndexedEdge {
+    Index p1, p2;
+
+    bool operator==(const BasicIndexedEdge& other) const {
+        return (p1 == other.p1 && p2 == other.p2) || (p1 == other.p2 && p2 == other.p1);
+    }
+};
+
+typedef BasicIndexedEdge<int> IndexedEdge;
+
+// Triangle adjacency: n[k] is the triangle across edge k (0 = a-b, 1 = b-c, 2 = c-a), or -1 on the boundary
+struct TriangleNeighbors {
+    int n[3];
+};
+
+// Per-vertex attribute channel stored struct-of-arrays: value k of vertex i is values[i * components + k]
+struct AttributeChannel {
+    std::string name;
+    int components;
+    std::vector<double> values;
+};
+
+// Attribute channels indexed like the input point array, so they follow vertex indices through triangulation
+struct PointAttributes {
+    std::vector<AttributeChannel> channels;
+
+    // Add a channel of 1 (scalar), 2 or 3 (vector) components; returns false on a shape mismatch
+    bool add(const std::string& name, int components, std::vector<double> values, size_t vertexCount) {
+        if (components < 1 || components > 3 || values.size() != vertexCount * components) {
+            std::cerr << "Error: Attribute " << name << " needs " << vertexCount << " x " << components
+                      << " values (1-3 components)" << std::endl;
+            return false;
+        }
+        channels.push_back({name, components, std::move(values)});
+        return true;
+    }
+
+    // Reorder all channels so that new vertex i takes the values of old vertex order[i]
+    void permute(const std::vector<int>& order) {
+        for (auto& ch : channels) {
+            std::vector<double> reordered(order.size() * ch.components);
+            for (size_t i = 0; i < order.size(); ++i) {
+                for (int k = 0; k < ch.components; ++k) {
+                    reordered[i * ch.components + k] = ch.values[static_cast<size_t>(order[i]) * ch.components + k];
+                }
+            }
+            ch.values.swap(reordered);
+        }
+    }
+};
+
+// Run fn(i) for every i in [0, count) on worker threads pulling indices from a shared counter
+template <typename Fn>
+void parallelFor(size_t count, unsigned numThreads, Fn fn) {
+    if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (numThreads > count) numThreads = static_cast<unsigned>(count);
+    if (numThreads <= 1) {
+        for (size_t i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < numThreads; ++t) {
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < count; i = next++) fn(i);
+        });
+    }
+    for (auto& w : workers) w.join();
+}
+
+// Memory accounting by data structure, switched on at run time with enableMemoryAccounting. Structures hold
+// an AccountedBytes handle and report their size when it changes; the ledger keeps current and peak bytes per
+// category across all threads. When accounting is off an update is one relaxed atomic load.
+enum MemoryCategory { memoryPoints, memoryTriangles, memoryAdjacency, memoryScratch, memoryExport,
+                      memoryCategoryCount };
+
+const char* const memoryCategoryNames[memoryCategoryCount] = {"points", "triangles", "adjacency", "scratch",
+                                                              "export"};
+
+class MemoryLedger {
+public:
+    static MemoryLedger& instance() {
+        static MemoryLedger ledger;
+        return ledger;
+    }
+
+    std::atomic<bool> enabled;
+
+    void add(MemoryCategory category, int64_t delta) {
+        raise(peak[category], current[category] += delta);
+        raise(peakTotal, total += delta);
+    }
+
+    int64_t currentBytes(int category) const { return current[category]; }
+    int64_t peakBytes(int category) const { return peak[category]; }
+    int64_t peakTotalBytes() const { return peakTotal; }
+
+    // Restart peaks from the current values
+    void resetPeaks() {
+        for (int c = 0; c < memoryCategoryCount; ++c) peak[c] = current[c].load();
+        peakTotal = total.load();
+    }
+
+    // Steady-state (current) and peak bytes per structure, with bytes per point
+    void write(std::ostream& out, size_t points) const {
+        double perPoint = 1.0 / std::max<size_t>(1, points);
+        for (int c = 0; c < memoryCategoryCount; ++c) {
+            out << memoryCategoryNames[c] << ": " << current[c] << " bytes steady (" << current[c] * perPoint
+                << "/point), " << peak[c] << " bytes peak (" << peak[c] * perPoint << "/point)" << std::endl;
+        }
+        out << "total: " << total << " bytes steady, " << peakTotal << " bytes peak (" << peakTotal * perPoint
+            << "/point)" << std::endl;
+    }
+
+private:
+    MemoryLedger() : enabled(false), total(0), peakTotal(0) {
+        for (int c = 0; c < memoryCategoryCount; ++c) current[c] = peak[c] = 0;
+    }
+
+    static void raise(std::atomic<int64_t>& peakValue, int64_t value) {
+        int64_t seen = peakValue.load(std::memory_order_relaxed);
+        while (value > seen && !peakValue.compare_exchange_weak(seen, value)) {}
+    }
+
+    std::atomic<int64_t> current[memoryCategoryCount], peak[memoryCategoryCount];
+    std::atomic<int64_t> total, peakTotal;
+};
+
+void enableMemoryAccounting() { MemoryLedger::instance().enabled = true; }
+
+// A structure's entry in the ledger; posts only the difference from its last reported size
+class AccountedBytes {
+public:
+    explicit AccountedBytes(MemoryCategory category, size_t bytes = 0) : category(category), reported(0) {
+        update(bytes);
+    }
+    AccountedBytes(const AccountedBytes& other) : category(other.category), reported(0) { update(other.reported); }
+    AccountedBytes& operator=(const AccountedBytes& other) {
+        update(other.reported);
+        return *this;
+    }
+    ~AccountedBytes() { update(0); }
+
+    void update(size_t bytes) {
+        if (bytes == reported || (!reported && !MemoryLedger::instance().enabled.load(std::memory_order_relaxed))) {
+            return;
+        }
+        MemoryLedger::instance().add(category, static_cast<int64_t>(bytes) - static_cast<int64_t>(reported));
+        reported = bytes;
+    }
+
+private:
+    MemoryCategory category;
+    size_t reported;
+};
+
+template <typename T, typename Allocator>
+size_t capacityBytes(const std::vector<T, Allocator>& v) {
+    return v.capacity() * sizeof(T);
+}
+
+const size_t cacheLineBytes = 64;
+
+// Allocator for cache-line aligned vector storage (operator new only honours alignof(max_align_t) before C++17)
+template <typename T>
+struct CacheAlignedAllocator {
+    typedef T value_type;
+
+    CacheAlignedAllocator() {}
+    template <typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        void* raw = std::malloc(n * sizeof(T) + sizeof(void*) + cacheLineBytes - 1);
+        if (!raw) throw std::bad_alloc();
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(raw) + sizeof(void*) + cacheLineBytes - 1) &
+                            ~uintptr_t(cacheLineBytes - 1);
+        reinterpret_cast<void**>(aligned)[-1] = raw;
+        return reinterpret_cast<T*>(aligned);
+    }
+
+    void deallocate(T* p, size_t) { std::free(reinterpret_cast<void**>(p)[-1]); }
+};
+
+template <typename T, typename U>
+bool operator==(const CacheAlignedAllocator<T>&, const CacheAlignedAllocator<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const CacheAlignedAllocator<T>&, const CacheAlignedAllocator<U>&) { return false; }
+
+// Circumcircle test on the triangle's vertices taken relative to the query point, shared by the scalar and block
+// kernels so both give bit-identical answers
+inline bool inCircumcircleRelative(double ax, double ay, double bx, double by, double cx, double cy) {
+    double a2 = ax * ax + ay * ay;
+    double b2 = bx * bx + by * by;
+    double c2 = cx * cx + cy * cy;
+    double det = a2 * (bx * cy - cx * by) -
+                 b2 * (ax * cy - cx * ay) +
+                 c2 * (ax * by - bx * ay);
+
+    // For a counter-clockwise triangle, the point is inside if det > 0
+    // We need to ensure triangles are consistently oriented (e.g., CCW)
+    // but for Bowyer-Watson, the sign consistency is what matters.
+    // The tolerance is relative to the magnitude of the terms, so it rejects rounding noise
+    // (co-circular points) at any coordinate scale without missing small circumcircles.
+    double magnitude = a2 * (std::fabs(bx * cy) + std::fabs(cx * by)) +
+                       b2 * (std::fabs(ax * cy) + std::fabs(cx * ay)) +
+                       c2 * (std::fabs(ax * by) + std::fabs(bx * ay));
+    return det > 1e-12 * magnitude;
+}
+
+// Function to check if point p is inside the circumcircle of triangle t
+bool inCircumcircle(const Point& p, const Triangle& t) {
+    return inCircumcircleRelative(t.a.x - p.x, t.a.y - p.y, t.b.x - p.x, t.b.y - p.y, t.c.x - p.x, t.c.y - p.y);
+}
+
+int exactOrient2d(const Point& a, const Point& b, const Point& c);
+int exactInCircle(const Point& a, const Point& b, const Point& c, const Point& d);
+
+// Circumcircle predicate for the core, selected at compile time from the coordinate type, with the type of the
+// core's vertex lanes (which also hold the super triangle). Floating-point coordinates keep their own type in the
+// lanes and use the tolerant test, evaluated in double (floats are promoted first); the super triangle spans
+// 40 times the input extent, so float inputs must stay below about 1e36 in magnitude.
+template <typename Scalar, bool isInteger = std::is_integral<Scalar>::value>
+struct CircumcirclePredicate {
+    typedef Scalar Lane;
+
+    static bool representable(Scalar) { return true; }
+
+    static bool inside(Lane ax, Lane ay, Lane bx, Lane by, Lane cx, Lane cy, Lane px, Lane py) {
+        return inCircumcircleRelative(double(ax) - double(px), double(ay) - double(py), double(bx) - double(px),
+                                      double(by) - double(py), double(cx) - double(px), double(cy) - double(py));
+    }
+};
+
+// Integer coordinates, usually grid-snapped and full of co-circular points, use the exact test on double lanes:
+// the super triangle cannot overflow there, and every integer up to 2^53 in magnitude converts exactly (the whole
+// int32 range; int64 inputs beyond it are rejected)
+template <typename Scalar>
+struct CircumcirclePredicate<Scalar, true> {
+    typedef double Lane;
+
+    static bool representable(Scalar v) {
+        return double(v) < 9007199254740992.0 && double(v) > -9007199254740992.0;
+    }
+
+    static bool inside(Lane ax, Lane ay, Lane bx, Lane by, Lane cx, Lane cy, Lane px, Lane py) {
+        Point a = {ax, ay}, b = {bx, by}, c = {cx, cy}, p = {px, py};
+        return exactInCircle(a, b, c, p) > 0;
+    }
+};
+
+// Per-phase profile of the core triangulation, compiled in with -DDELAUNAY_PROFILE. Each thread accumulates
+// into its own record (merged when the thread exits), so the hot path takes no locks; without the flag the
+// PROFILE_* macros expand to nothing.
+enum ProfilePhase { phaseCircumcircleScan, phaseRemoveBad, phaseUniqueEdges, phaseInsertTriangles,
+                    phaseSuperFilter, phaseCount };
+
+const char* const profilePhaseNames[phaseCount] = {"circumcircle_scan", "remove_bad", "unique_edges",
+                                                   "insert_triangles", "super_triangle_filter"};
+
+struct TriangulationProfile {
+    static const int cavityBuckets = 16;  // bucket b counts cavities of [2^(b-1), 2^b) triangles, the last is open
+
+    uint64_t nanos[phaseCount];
+    uint64_t calls[phaseCount];
+    uint64_t triangulations, insertions, incircleTests, badTriangles;
+    uint64_t cavityHistogram[cavityBuckets];
+
+    TriangulationProfile() { std::memset(this, 0, sizeof(*this)); }
+
+    void merge(const TriangulationProfile& other) {
+        for (int p = 0; p < phaseCount; ++p) {
+            nanos[p] += other.nanos[p];
+            calls[p] += other.calls[p];
+        }
+        triangulations += other.triangulations;
+        insertions += other.insertions;
+        incircleTests += other.incircleTests;
+        badTriangles += other.badTriangles;
+        for (int b = 0; b < cavityBuckets; ++b) cavityHistogram[b] += other.cavityHistogram[b];
+    }
+
+    void recordCavity(size_t size) {
+        int bucket = 0;
+        while (bucket + 1 < cavityBuckets && (size_t(1) << bucket) <= size) ++bucket;
+        ++cavityHistogram[bucket];
+        badTriangles += size;
+    }
+
+    // Structured report as a JSON object
+    void write(std::ostream& out) const {
+        out << "{\n  \"triangulations\": " << triangulations << ",\n  \"insertions\": " << insertions
+            << ",\n  \"incircle_tests\": " << incircleTests << ",\n  \"bad_triangles\": " << badTriangles
+            << ",\n  \"phases\": {";
+        for (int p = 0; p < phaseCount; ++p) {
+            out << (p ? "," : "") << "\n    \"" << profilePhaseNames[p] << "\": {\"seconds\": " << nanos[p] * 1e-9
+                << ", \"calls\": " << calls[p] << "}";
+        }
+        out << "\n  },\n  \"cavity_histogram\": [";
+        for (int b = 0; b < cavityBuckets; ++b) out << (b ? ", " : "") << cavityHistogram[b];
+        out << "]\n}\n";
+    }
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if defined(DELAUNAY_PROFILE)
+// Registry of live per-thread records plus the totals of threads that have exited
+class ProfileRegistry {
+public:
+    static ProfileRegistry& instance() {
+        static ProfileRegistry registry;
+        return registry;
+    }
+
+    void add(TriangulationProfile* profile) {
+        std::lock_guard<std::mutex> lock(mutex);
+        live.insert(profile);
+    }
+
+    void retire(TriangulationProfile* profile) {
+        std::lock_guard<std::mutex> lock(mutex);
+        retired.merge(*profile);
+        live.erase(profile);
+    }
+
+    // Only meaningful while no triangulation is running
+    TriangulationProfile collect() {
+        std::lock_guard<std::mutex> lock(mutex);
+        TriangulationProfile total = retired;
+        for (auto* profile : live) total.merge(*profile);
+        return total;
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex);
+        retired = TriangulationProfile();
+        for (auto* profile : live) *profile = TriangulationProfile();
+    }
+
+private:
+    std::mutex mutex;
+    std::set<TriangulationProfile*> live;
+    TriangulationProfile retired;
+};
+
+struct ThreadProfile {
+    TriangulationProfile data;
+    ThreadProfile() { ProfileRegistry::instance().add(&data); }
+    ~ThreadProfile() { ProfileRegistry::instance().retire(&data); }
+};
+
+static TriangulationProfile& threadProfile() {
+    static thread_local ThreadProfile profile;
+    return profile.data;
+}
+
+// Adds the lifetime of the enclosing scope to a phase of the calling thread's profile
+class ScopedPhaseTimer {
+public:
+    explicit ScopedPhaseTimer(ProfilePhase phase) : phase(phase), start(std::chrono::steady_clock::now()) {}
+    ~ScopedPhaseTimer() {
+        TriangulationProfile& profile = threadProfile();
+        profile.nanos[phase] += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        ++profile.calls[phase];
+    }
+
+private:
+    ProfilePhase phase;
+    std::chrono::steady_clock::time_point start;
+};
+
+TriangulationProfile collectTriangulationProfile() { return ProfileRegistry::instance().collect(); }
+void resetTriangulationProfile() { ProfileRegistry::instance().reset(); }
+
+#define PROFILE_PHASE(phase) ScopedPhaseTimer PROFILE_CONCAT(profilePhase, __LINE__)(phase)
+#define PROFILE_COUNT(counter, n) (threadProfile().counter += (n))
+#define PROFILE_CAVITY(size) threadProfile().recordCavity(size)
+#else
+TriangulationProfile collectTriangulationProfile() { return TriangulationProfile(); }
+void resetTriangulationProfile() {}
+
+#define PROFILE_PHASE(phase)
+#define PROFILE_COUNT(counter, n)
+#define PROFILE_CAVITY(size)
+#endif
+
+// Event tracing for Chrome / Perfetto (chrome://tracing, ui.perfetto.dev). Tracing is switched on at run time
+// with startTracing; when off a TRACE_SCOPE costs one relaxed atomic load. Each thread records complete events
+// into its own fixed-size ring buffer (oldest events are overwritten), published with a release store of the
+// head, so recording takes no locks. writeChromeTrace should run once the traced work has finished.
+struct TraceEvent {
+    const char* name;  // must be a string literal or otherwise outlive the trace
+    uint64_t startNanos, durationNanos;
+};
+
+struct TraceBuffer {
+    std::vector<TraceEvent> events;
+    std::atomic<uint64_t> head;
+    int tid;
+    std::string threadName;
+
+    TraceBuffer(size_t capacity, int tid) : events(capacity), head(0), tid(tid) {}
+
+    void record(const TraceEvent& event) {
+        uint64_t index = head.load(std::memory_order_relaxed);
+        events[index % events.size()] = event;
+        head.store(index + 1, std::memory_order_release);
+    }
+};
+
+class Tracer {
+public:
+    static Tracer& instance() {
+        static Tracer tracer;
+        return tracer;
+    }
+
+    std::atomic<bool> enabled;
+
+    void start(size_t eventsPerThread) {
+        std::lock_guard<std::mutex> lock(mutex);
+        capacity = std::max<size_t>(1, eventsPerThread);
+        origin = std::chrono::steady_clock::now();
+        ++generation;
+        buffers.clear();
+        enabled = true;
+    }
+
+    uint64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+    }
+
+    // The calling thread's buffer for the current trace; buffers are owned here so they outlive their threads
+    TraceBuffer& threadBuffer() {
+        static thread_local TraceBuffer* buffer = nullptr;
+        static thread_local uint64_t bufferGeneration = 0;
+        if (!buffer || bufferGeneration != generation) {
+            std::lock_guard<std::mutex> lock(mutex);
+            buffers.emplace_back(new TraceBuffer(capacity, static_cast<int>(buffers.size()) + 1));
+            buffer = buffers.back().get();
+            bufferGeneration = generation;
+        }
+        return *buffer;
+    }
+
+    bool write(const std::string& filename) {
+        std::ofstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        const int pid = 1;
+        char number[64];
+        bool first = true;
+        file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+        for (const auto& buffer : buffers) {
+            std::string name = buffer->threadName.empty() ? "thread " + std::to_string(buffer->tid)
+                                                          : buffer->threadName;
+            file << (first ? "\n" : ",\n") << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": " << pid
+                 << ", \"tid\": " << buffer->tid << ", \"args\": {\"name\": \"" << name << "\"}}";
+            first = false;
+            uint64_t head = buffer->head.load(std::memory_order_acquire);
+            uint64_t size = buffer->events.size();
+            for (uint64_t i = head > size ? head - size : 0; i < head; ++i) {
+                const TraceEvent& event = buffer->events[i % size];
+                std::snprintf(number, sizeof(number), "%.3f, \"dur\": %.3f", event.startNanos * 1e-3,
+                              event.durationNanos * 1e-3);
+                file << ",\n{\"name\": \"" << event.name << "\", \"cat\": \"delaunay\", \"ph\": \"X\", \"ts\": "
+                     << number << ", \"pid\": " << pid << ", \"tid\": " << buffer->tid << "}";
+            }
+        }
+        file << "\n]}\n";
+        file.close();
+        std::cout << "Exported to " << filename << std::endl;
+        return true;
+    }
+
+private:
+    Tracer() : enabled(false), capacity(1 << 16), generation(0) {}
+
+    std::mutex mutex;
+    size_t capacity;
+    std::atomic<uint64_t> generation;
+    std::chrono::steady_clock::time_point origin;
+    std::vector<std::unique_ptr<TraceBuffer>> buffers;
+};
+
+// Start a new trace, discarding any previous one
+void startTracing(size_t eventsPerThread = 1 << 16) { Tracer::instance().start(eventsPerThread); }
+void stopTracing() { Tracer::instance().enabled = false; }
+bool writeChromeTrace(const std::string& filename) { return Tracer::instance().write(filename); }
+
+// Label the calling thread in the trace (e.g. "reader", "worker")
+void setTraceThreadName(const std::string& name) {
+    if (Tracer::instance().enabled.load(std::memory_order_relaxed)) Tracer::instance().threadBuffer().threadName = name;
+}
+
+// Records the enclosing scope as one complete event; end() closes it early
+class TraceScope {
+public:
+    explicit TraceScope(const char* name) : name(nullptr), start(0) { begin(name); }
+    ~TraceScope() { end(); }
+
+    void begin(const char* eventName) {
+        end();
+        if (!Tracer::instance().enabled.load(std::memory_order_relaxed)) return;
+        name = eventName;
+        start = Tracer::instance().now();
+    }
+
+    void end() {
+        if (!name) return;
+        Tracer& tracer = Tracer::instance();
+        TraceEvent event = {name, start, tracer.now() - start};
+        tracer.threadBuffer().record(event);
+        name = nullptr;
+    }
+
+private:
+    const char* name;
+    uint64_t start;
+};
+
+#define TRACE_SCOPE(name) TraceScope PROFILE_CONCAT(traceScope, __LINE__)(name)
+
+// Hardware counter totals for a measured region (scaled if the kernel multiplexed the counters)
+struct PerfSample {
+    uint64_t cycles, instructions, cacheMisses, branchMisses;
+
+    PerfSample operator-(const PerfSample& other) const {
+        return {cycles - other.cycles, instructions - other.instructions, cacheMisses - other.cacheMisses,
+                branchMisses - other.branchMisses};
+    }
+};
+
+// User-space cycles, instructions, cache misses and branch mispredictions of this process via perf_event_open.
+// Counters are inherited by threads created after opening, so parallel phases are included; reading costs a
+// few system calls, so regions should be phases rather than single insertions.
+class PerfCounters {
+public:
+    PerfCounters() {
+        for (auto& fd : fds) fd = -1;
+#if defined(__linux__)
+        const uint64_t configs[eventCount] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                              PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (int e = 0; e < eventCount; ++e) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[e];
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            fds[e] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (int fd : fds) {
+            if (fd >= 0) ::close(fd);
+        }
+#endif
+    }
+
+    // False if the kernel refused the counters (no PMU, perf_event_paranoid, seccomp); samples are then zero
+    bool available() const {
+        for (int fd : fds) {
+            if (fd < 0) return false;
+        }
+        return true;
+    }
+
+    PerfSample read() const {
+        uint64_t values[eventCount] = {0, 0, 0, 0};
+#if defined(__linux__)
+        for (int e = 0; e < eventCount; ++e) {
+            uint64_t raw[3];  // value, time enabled, time running
+            if (fds[e] < 0 || ::read(fds[e], raw, sizeof(raw)) != sizeof(raw)) continue;
+            values[e] = raw[2] && raw[2] < raw[1] ? static_cast<uint64_t>(double(raw[0]) * raw[1] / raw[2]) : raw[0];
+        }
+#endif
+        return {values[0], values[1], values[2], values[3]};
+    }
+
+private:
+    PerfCounters(const PerfCounters&);
+    PerfCounters& operator=(const PerfCounters&);
+
+    static const int eventCount = 4;
+    int fds[eventCount];
+};
+
+// Counter deltas between successive marks, reported per phase with IPC and misses per inserted point
+class PerfReport {
+public:
+    explicit PerfReport(const PerfCounters& counters) : counters(counters), last(counters.read()) {}
+
+    // Start the next phase here, dropping anything counted since the previous mark
+    void begin() { last = counters.read(); }
+
+    // Close the current phase under this name and start the next one
+    void mark(const std::string& phase) {
+        PerfSample now = counters.read();
+        phases.push_back(std::make_pair(phase, now - last));
+        last = now;
+    }
+
+    void write(std::ostream& out, size_t points) const {
+        if (!counters.available()) {
+            out << "Hardware counters unavailable (perf_event_open failed)." << std::endl;
+            return;
+        }
+        double perPoint = 1.0 / std::max<size_t>(1, points);
+        for (const auto& phase : phases) {
+            const PerfSample& s = phase.second;
+            out << phase.first << ": " << s.cycles << " cycles, " << s.instructions << " instructions, IPC "
+                << (s.cycles ? double(s.instructions) / s.cycles : 0.0) << ", " << s.cacheMisses
+                << " cache misses (" << s.cacheMisses * perPoint << "/point), " << s.branchMisses
+                << " branch misses (" << s.branchMisses * perPoint << "/point)" << std::endl;
+        }
+    }
+
+private:
+    const PerfCounters& counters;
+    PerfSample last;
+    std::vector<std::pair<std::string, PerfSample>> phases;
+};
+
+// Vertex coordinates split into cache-line aligned x and y lanes for the block kernels; Point views on demand
+template <typename Scalar>
+struct VertexLanes {
+    typedef typename CircumcirclePredicate<Scalar>::Lane Lane;
+    std::vector<Lane, CacheAlignedAllocator<Lane>> x, y;
+
+    // Copy points followed by extra (e.g. super triangle) vertices, reusing the lanes' storage
+    void assign(BasicPointSpan<Scalar> points, const BasicPoint<Lane>* extra, size_t extraCount) {
+        x.resize(points.size() + extraCount);
+        y.resize(points.size() + extraCount);
+        for (size_t i = 0; i < points.size(); ++i) {
+            x[i] = points[i].x;
+            y[i] = points[i].y;
+        }
+        for (size_t i = 0; i < extraCount; ++i) {
+            x[points.size() + i] = extra[i].x;
+            y[points.size() + i] = extra[i].y;
+        }
+    }
+
+    BasicPoint<Lane> operator[](size_t i) const { return {x[i], y[i]}; }
+    size_t bytes() const { return capacityBytes(x) + capacityBytes(y); }
+};
+
+const int triangleBlockSize = 16;
+
+// Sixteen triangles as vertex index lanes: three cache lines with 32-bit indices (six with 64-bit) when aligned.
+// A free or unused lane has a = -1 and b, c still valid, so kernels can run over whole blocks and mask the result.
+template <typename Index>
+struct TriangleBlock {
+    Index a[triangleBlockSize], b[triangleBlockSize], c[triangleBlockSize];
+};
+
+// Circumcircle test of (px, py) against every lane of a block: bit k is set if triangle k is live and its
+// circumcircle strictly contains the point. Lanes are independent and branch-free, so the loop vectorizes (with
+// gathers for the vertex coordinates) where the target allows.
+template <typename Scalar, typename Index>
+inline unsigned inCircumcircleBlock(const VertexLanes<Scalar>& v, const TriangleBlock<Index>& block,
+                                    typename VertexLanes<Scalar>::Lane px, typename VertexLanes<Scalar>::Lane py) {
+    bool inside[triangleBlockSize];
+    for (int k = 0; k < triangleBlockSize; ++k) {
+        Index a = std::max<Index>(block.a[k], 0), b = block.b[k], c = block.c[k];
+        inside[k] = (block.a[k] >= 0) &
+                    CircumcirclePredicate<Scalar>::inside(v.x[a], v.y[a], v.x[b], v.y[b], v.x[c], v.y[c], px, py);
+    }
+    unsigned mask = 0;
+    for (int k = 0; k < triangleBlockSize; ++k) mask |= unsigned(inside[k]) << k;
+    return mask;
+}
+
+// Triangle storage for incremental insertion, in cache-line aligned index blocks. Removed triangles leave a dead
+// lane on a free list that the next cavity's fan reuses, so once reserved the pool never reallocates while
+// inserting. operator[] gives an IndexedTriangle view of a slot.
+template <typename Index>
+class TrianglePool {
+public:
+    TrianglePool() : slots(0), live(0) {}
+
+    // Drop all triangles, keeping room for capacity slots
+    void reset(size_t capacity) {
+        blocks.clear();
+        freeSlots.clear();
+        blocks.reserve((capacity + triangleBlockSize - 1) / triangleBlockSize);
+        freeSlots.reserve(capacity);
+        slots = 0;
+        live = 0;
+    }
+
+    Index add(const BasicIndexedTriangle<Index>& t) {
+        ++live;
+        size_t slot;
+        if (freeSlots.empty()) {
+            if (slots % triangleBlockSize == 0) {
+                TriangleBlock<Index> empty;
+                std::fill(empty.a, empty.a + triangleBlockSize, -1);
+                std::fill(empty.b, empty.b + triangleBlockSize, 0);
+                std::fill(empty.c, empty.c + triangleBlockSize, 0);
+                blocks.push_back(empty);
+            }
+            slot = slots++;
+        } else {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        }
+        TriangleBlock<Index>& block = blocks[slot / triangleBlockSize];
+        size_t lane = slot % triangleBlockSize;
+        block.a[lane] = t.a;
+        block.b[lane] = t.b;
+        block.c[lane] = t.c;
+        return static_cast<Index>(slot);
+    }
+
+    void remove(Index slot) {
+        blocks[slot / triangleBlockSize].a[slot % triangleBlockSize] = -1;
+        freeSlots.push_back(slot);
+        --live;
+    }
+
+    // Slots in use or free; iterate 0..slotCount() and skip !alive(), or run a kernel over each block
+    size_t slotCount() const { return slots; }
+    size_t liveCount() const { return live; }
+    size_t blockCount() const { return blocks.size(); }
+    const TriangleBlock<Index>& block(size_t i) const { return blocks[i]; }
+
+    bool alive(size_t slot) const { return blocks[slot / triangleBlockSize].a[slot % triangleBlockSize] >= 0; }
+    BasicIndexedTriangle<Index> operator[](size_t slot) const {
+        const TriangleBlock<Index>& block = blocks[slot / triangleBlockSize];
+        size_t lane = slot % triangleBlockSize;
+        return {block.a[lane], block.b[lane], block.c[lane]};
+    }
+
+    size_t bytes() const { return capacityBytes(blocks) + capacityBytes(freeSlots); }
+
+private:
+    std::vector<TriangleBlock<Index>, CacheAlignedAllocator<TriangleBlock<Index>>> blocks;
+    std::vector<Index> freeSlots;
+    size_t slots, live;
+};
+
+// Per-insertion work buffers; reusing one per thread keeps repeated triangulations from allocating
+template <typename Scalar, typename Index>
+struct BasicTriangulationScratch {
+    VertexLanes<Scalar> vertices;
+    TrianglePool<Index> pool;
+    std::vector<Index> badTriangles;  // pool slots
+    std::vector<BasicIndexedEdge<Index>> polygon;
+    std::vector<BasicIndexedEdge<Index>> uniqueEdges;
+
+    size_t bytes() const {
+        return vertices.bytes() + capacityBytes(badTriangles) + capacityBytes(polygon) + capacityBytes(uniqueEdges);
+    }
+};
+
+typedef BasicTriangulationScratch<double, int> TriangulationScratch;
+
+// The finite super triangle loses the hull triangles whose circumcircles reach one of its vertices, which leaves
+// reflex pockets along the boundary. Given the boundary edges (interior on the left), fill each pocket with a
+// Graham scan from the lowest boundary vertex, which is on the hull, then make the mesh Delaunay again with exact
+// Lawson flips. point(v) gives the coordinates of vertex v; a boundary that is not one simple loop is left as it is.
+template <typename Index, typename PointOf>
+void fillConvexHull(PointOf point, const std::vector<BasicIndexedEdge<Index>>& boundary,
+                    std::vector<BasicIndexedTriangle<Index>>& triangles) {
+    std::map<Index, Index> next;
+    Index start = boundary.empty() ? 0 : boundary[0].p1;
+    for (const auto& e : boundary) {
+        if (!next.insert(std::make_pair(e.p1, e.p2)).second) return;
+        Point p = point(e.p1), s = point(start);
+        if (p.y < s.y || (p.y == s.y && p.x < s.x)) start = e.p1;
+    }
+    std::vector<Index> loop;
+    for (Index v = start; loop.size() <= boundary.size(); v = next[v]) {
+        if (!next.count(v)) return;
+        loop.push_back(v);
+        if (next[v] == start) break;
+    }
+    if (loop.size() < 3 || loop.size() != boundary.size()) return;
+    loop.push_back(start);
+
+    // A right turn u, v, w along the boundary is a pocket: (u, w, v) closes it
+    const size_t firstNew = triangles.size();
+    std::vector<Index> chain;
+    for (Index w : loop) {
+        while (chain.size() >= 2 && exactOrient2d(point(chain[chain.size() - 2]), point(chain.back()), point(w)) < 0) {
+            triangles.push_back({chain[chain.size() - 2], w, chain.back()});
+            chain.pop_back();
+        }
+        chain.push_back(w);
+    }
+    if (triangles.size() == firstNew) return;
+
+    // Flip edges whose opposite vertex is strictly inside the circumcircle, starting from the new triangles
+    typedef std::pair<Index, Index> DirectedEdge;
+    std::map<DirectedEdge, size_t> owner;
+    auto own = [&](size_t t) {
+        const BasicIndexedTriangle<Index>& tri = triangles[t];
+        owner[DirectedEdge(tri.a, tri.b)] = t;
+        owner[DirectedEdge(tri.b, tri.c)] = t;
+        owner[DirectedEdge(tri.c, tri.a)] = t;
+    };
+    // The vertex before a, which is opposite the directed edge leaving a
+    auto before = [](const BasicIndexedTriangle<Index>& t, Index a) { return t.a == a ? t.c : (t.b == a ? t.a : t.b); };
+    for (size_t t = 0; t < triangles.size(); ++t) own(t);
+    std::vector<DirectedEdge> pending;
+    for (size_t t = firstNew; t < triangles.size(); ++t) {
+        pending.push_back(DirectedEdge(triangles[t].a, triangles[t].b));
+        pending.push_back(DirectedEdge(triangles[t].b, triangles[t].c));
+        pending.push_back(DirectedEdge(triangles[t].c, triangles[t].a));
+    }
+    while (!pending.empty()) {
+        const Index a = pending.back().first, b = pending.back().second;
+        pending.pop_back();
+        auto left = owner.find(DirectedEdge(a, b)), right = owner.find(DirectedEdge(b, a));
+        if (left == owner.end() || right == owner.end()) continue;
+        const size_t t1 = left->second, t2 = right->second;
+        const Index c = before(triangles[t1], a), d = before(triangles[t2], b);
+        if (exactInCircle(point(a), point(b), point(c), point(d)) <= 0) continue;
+        owner.erase(left);
+        owner.erase(right);
+        triangles[t1] = {a, d, c};
+        triangles[t2] = {d, b, c};
+        own(t1);
+        own(t2);
+        pending.push_back(DirectedEdge(a, d));
+        pending.push_back(DirectedEdge(d, b));
+        pending.push_back(DirectedEdge(b, c));
+        pending.push_back(DirectedEdge(c, a));
+    }
+}
+
+// Delaunay triangulation into triangles (cleared first) as indices into points, using caller-owned scratch.
+// Scalar is the coordinate type (float halves the vertex lanes; integers are triangulated exactly in double lanes,
+// up to 2^53 in magnitude) and Index the vertex index width: 32-bit indices limit a run to 2^31 - 1 points,
+// 64-bit ones double the triangle blocks. Out-of-range integer input is reported and leaves triangles empty.
+template <typename Scalar, typename Index>
+void delaunayTriangulationIndexed(BasicPointSpan<Scalar> points, std::vector<BasicIndexedTriangle<Index>>& triangles,
+                                  BasicTriangulationScratch<Scalar, Index>& scratch) {
+    typedef CircumcirclePredicate<Scalar> Predicate;
+    typedef typename Predicate::Lane Lane;
+    triangles.clear();
+
+    // Determine the bounds of the points
+    Scalar minX = points[0].x;
+    Scalar minY = points[0].y;
+    Scalar maxX = minX;
+    Scalar maxY = minY;
+    for (const auto& p : points) {
+        minX = std::min(minX, p.x);
+        minY = std::min(minY, p.y);
+        maxX = std::max(maxX, p.x);
+        maxY = std::max(maxY, p.y);
+    }
+    if (!Predicate::representable(minX) || !Predicate::representable(minY) || !Predicate::representable(maxX) ||
+        !Predicate::representable(maxY)) {
+        std::cerr << "Error: Integer coordinates beyond 2^53 in magnitude cannot be triangulated exactly" << std::endl;
+        return;
+    }
+
+    // The extent and the super triangle are computed in the lane type, which cannot overflow for integer input
+    Lane dx = Lane(maxX) - Lane(minX);
+    Lane dy = Lane(maxY) - Lane(minY);
+    Lane deltaMax = std::max(dx, dy);
+    Lane midX = (Lane(minX) + Lane(maxX)) / 2;
+    Lane midY = (Lane(minY) + Lane(maxY)) / 2;
+
+    // Create a super triangle that encompasses all points; its vertices are numbered after the input points
+    const BasicPoint<Lane> superVertices[3] = {
+        {midX - 20 * deltaMax, midY - deltaMax},
+        {midX + 20 * deltaMax, midY - deltaMax},
+        {midX, midY + 20 * deltaMax}};
+    const Index superBase = static_cast<Index>(points.size());
+    VertexLanes<Scalar>& vertices = scratch.vertices;
+    vertices.assign(points, superVertices, 3);
+
+    // n points plus the three super vertices, all on a triangular hull, give at most 2n + 1 triangles (Euler)
+    TrianglePool<Index>& pool = scratch.pool;
+    pool.reset(2 * points.size() + 1);
+    pool.add({superBase, superBase + 1, superBase + 2});
+    std::vector<Index>& badTriangles = scratch.badTriangles;
+    std::vector<BasicIndexedEdge<Index>>& polygon = scratch.polygon;
+    std::vector<BasicIndexedEdge<Index>>& uniqueEdges = scratch.uniqueEdges;
+    badTriangles.reserve(64);
+    polygon.reserve(3 * badTriangles.capacity());
+    uniqueEdges.reserve(polygon.capacity());
+
+    PROFILE_COUNT(triangulations, 1);
+    PROFILE_COUNT(insertions, superBase);
+    TRACE_SCOPE("triangulate");
+    AccountedBytes triangleBytes(memoryTriangles, pool.bytes()), scratchBytes(memoryScratch, scratch.bytes());
+    TraceScope insertBatch(nullptr);
+
+    for (Index pi = 0; pi < superBase; ++pi) {
+        const Lane px = vertices.x[pi], py = vertices.y[pi];
+        if (pi % 4096 == 0) insertBatch.begin("insert_batch");
+        badTriangles.clear();
+        polygon.clear();
+        uniqueEdges.clear();
+        size_t scratchCapacity = badTriangles.capacity() + polygon.capacity() + uniqueEdges.capacity();
+
+        // Find triangles whose circumcircle contains the point, a block of index lanes at a time
+        {
+            PROFILE_PHASE(phaseCircumcircleScan);
+            PROFILE_COUNT(incircleTests, pool.liveCount());
+            for (size_t bi = 0; bi < pool.blockCount(); ++bi) {
+                const TriangleBlock<Index>& block = pool.block(bi);
+                unsigned inside = inCircumcircleBlock(vertices, block, px, py);
+                for (int k = 0; inside; ++k, inside >>= 1) {
+                    if (!(inside & 1)) continue;
+                    badTriangles.push_back(static_cast<Index>(bi * triangleBlockSize + k));
+                    polygon.push_back({block.a[k], block.b[k]});
+                    polygon.push_back({block.b[k], block.c[k]});
+                    polygon.push_back({block.c[k], block.a[k]});
+                }
+            }
+            PROFILE_CAVITY(badTriangles.size());
+        }
+
+        // Remove bad triangles from the triangulation
+        {
+            PROFILE_PHASE(phaseRemoveBad);
+            for (Index slot : badTriangles) pool.remove(slot);
+        }
+
+        // Find the unique edges of the polygonal hole
+        {
+            PROFILE_PHASE(phaseUniqueEdges);
+            for (size_t i = 0; i < polygon.size(); ++i) {
+                bool isUnique = true;
+                for (size_t j = 0; j < polygon.size(); ++j) {
+                    if (i != j && polygon[i] == polygon[j]) {
+                        isUnique = false;
+                        break;
+                    }
+                }
+                if (isUnique) {
+                    uniqueEdges.push_back(polygon[i]);
+                }
+            }
+        }
+
+        // Create new triangles from the point to the unique edges
+        {
+            PROFILE_PHASE(phaseInsertTriangles);
+            for (const auto& edge : uniqueEdges) {
+                pool.add({edge.p1, edge.p2, pi});
+            }
+        }
+        if (badTriangles.capacity() + polygon.capacity() + uniqueEdges.capacity() != scratchCapacity) {
+            scratchBytes.update(scratch.bytes());
+        }
+    }
+
+    // Keep the triangles that do not share a vertex with the super triangle; those with exactly one give the
+    // boundary of the rest, reversed, for the hull repair
+    insertBatch.end();
+    PROFILE_PHASE(phaseSuperFilter);
+    triangles.reserve(pool.liveCount());
+    polygon.clear();
+    for (size_t slot = 0; slot < pool.slotCount(); ++slot) {
+        if (!pool.alive(slot)) continue;
+        BasicIndexedTriangle<Index> t = pool[slot];
+        if (t.a < superBase && t.b < superBase && t.c < superBase) {
+            triangles.push_back(t);
+        } else if (t.a >= superBase && t.b < superBase && t.c < superBase) {
+            polygon.push_back({t.c, t.b});
+        } else if (t.b >= superBase && t.c < superBase && t.a < superBase) {
+            polygon.push_back({t.a, t.c});
+        } else if (t.c >= superBase && t.a < superBase && t.b < superBase) {
+            polygon.push_back({t.b, t.a});
+        }
+    }
+    fillConvexHull([&](Index v) { return Point{double(vertices.x[v]), double(vertices.y[v])}; }, polygon, triangles);
+}
+
+// Delaunay triangulation into triangles (cleared first) as indices into points, using caller-owned scratch
+void delaunayTriangulationIndexed(PointSpan points, std::vector<IndexedTriangle>& triangles,
+                                  TriangulationScratch& scratch) {
+    delaunayTriangulationIndexed<double, int>(points, triangles, scratch);
+}
+
+// Delaunay triangulation of points with other coordinate or index types, e.g. <float, int> or <double, int64_t>
+template <typename Scalar, typename Index>
+std::vector<BasicIndexedTriangle<Index>> delaunayTriangulationIndexed(BasicPointSpan<Scalar> points) {
+    std::vector<BasicIndexedTriangle<Index>> triangles;
+    BasicTriangulationScratch<Scalar, Index> scratch;
+    delaunayTriangulationIndexed(points, triangles, scratch);
+    return triangles;
+}
+
+// Delaunay triangulation function returning triangles as indices into points
+std::vector<IndexedTriangle> delaunayTriangulationIndexed(PointSpan points) {
+    std::vector<IndexedTriangle> triangles;
+    TriangulationScratch scratch;
+    delaunayTriangulationIndexed(points, triangles, scratch);
+    return triangles;
+}
+
+// Delaunay triangulation function
+std::vector<Triangle> delaunayTriangulation(std::vector<Point>& points) {
+    std::vector<IndexedTriangle> indexed = delaunayTriangulationIndexed(points);
+
+    std::vector<Triangle> triangles;
+    triangles.reserve(indexed.size());
+    for (const auto& t : indexed) {
+        triangles.push_back({points[t.a], points[t.b], points[t.c]});
+    }
+    return triangles;
+}
+
+// Regular raster grid; pixel (i, j) has its center at origin + ((i + 0.5) * cellWidth, (j + 0.5) * cellHeight)
+struct GridSpec {
+    double originX, originY;
+    double cellWidth, cellHeight;
+    int width, height;
+};
+
+// Rasterize one triangle's pixel range [x0, x1] x [y0, y1] with incremental edge functions
+static void rasterizeTriangleSpan(const Point& a, const Point& b, const Point& c,
+                                  double va, double vb, double vc, const GridSpec& grid,
+                                  int x0, int x1, int y0, int y1, double* out) {
+    double area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (area == 0.0) return;
+    if (area < 0.0) {
+        // Flip to counter-clockwise so that interior pixels have non-negative edge functions
+        rasterizeTriangleSpan(a, c, b, va, vc, vb, grid, x0, x1, y0, y1, out);
+        return;
+    }
+    double invArea = 1.0 / area;
+
+    // Edge function E(p) = A * (p.x - s.x) + B * (p.y - s.y) for edge s -> e; w0 weights a, w1 weights b, w2 weights c
+    double A0 = b.y - c.y, B0 = c.x - b.x;
+    double A1 = c.y - a.y, B1 = a.x - c.x;
+    double A2 = a.y - b.y, B2 = b.x - a.x;
+    double stepX0 = A0 * grid.cellWidth;
+    double stepX1 = A1 * grid.cellWidth;
+    double stepX2 = A2 * grid.cellWidth;
+
+    double px = grid.originX + (x0 + 0.5) * grid.cellWidth;
+    for (int y = y0; y <= y1; ++y) {
+        double py = grid.originY + (y + 0.5) * grid.cellHeight;
+        double w0 = A0 * (px - b.x) + B0 * (py - b.y);
+        double w1 = A1 * (px - c.x) + B1 * (py - c.y);
+        double w2 = A2 * (px - a.x) + B2 * (py - a.y);
+        double* row = out + static_cast<size_t>(y) * grid.width;
+        int x = x0;
+
+#if defined(__SSE2__)
+        // Two pixels per step: lanes hold the edge functions at x and x + 1
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d scale = _mm_set1_pd(invArea);
+        const __m128d vA = _mm_set1_pd(va), vB = _mm_set1_pd(vb), vC = _mm_set1_pd(vc);
+        __m128d l0 = _mm_set_pd(w0 + stepX0, w0), l1 = _mm_set_pd(w1 + stepX1, w1), l2 = _mm_set_pd(w2 + stepX2, w2);
+        const __m128d s0 = _mm_set1_pd(2 * stepX0), s1 = _mm_set1_pd(2 * stepX1), s2 = _mm_set1_pd(2 * stepX2);
+        for (; x + 1 <= x1; x += 2) {
+            __m128d inside = _mm_and_pd(_mm_and_pd(_mm_cmpge_pd(l0, zero), _mm_cmpge_pd(l1, zero)),
+                                        _mm_cmpge_pd(l2, zero));
+            if (_mm_movemask_pd(inside)) {
+                __m128d value = _mm_mul_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(l0, vA), _mm_mul_pd(l1, vB)),
+                                                      _mm_mul_pd(l2, vC)), scale);
+                __m128d old = _mm_loadu_pd(row + x);
+                _mm_storeu_pd(row + x, _mm_or_pd(_mm_and_pd(inside, value), _mm_andnot_pd(inside, old)));
+            }
+            l0 = _mm_add_pd(l0, s0);
+            l1 = _mm_add_pd(l1, s1);
+            l2 = _mm_add_pd(l2, s2);
+        }
+        w0 = _mm_cvtsd_f64(l0);
+        w1 = _mm_cvtsd_f64(l1);
+        w2 = _mm_cvtsd_f64(l2);
+#endif
+
+        for (; x <= x1; ++x) {
+            if (w0 >= 0 && w1 >= 0 && w2 >= 0) {
+                row[x] = (w0 * va + w1 * vb + w2 * vc) * invArea;
+            }
+            w0 += stepX0;
+            w1 += stepX1;
+            w2 += stepX2;
+        }
+    }
+}
+
+// Resample per-vertex values onto a regular grid by barycentric interpolation.
+// out must hold grid.width * grid.height values (row-major, row 0 at originY); pixels outside the mesh are left untouched.
+void rasterizeField(PointSpan vertices, const std::vector<IndexedTriangle>& triangles,
+                    const std::vector<double>& values, const GridSpec& grid, double* out,
+                    unsigned numThreads = 0) {
+    const int tileSize = 64;
+    if (grid.width <= 0 || grid.height <= 0) return;
+    int tilesX = (grid.width + tileSize - 1) / tileSize;
+    int tilesY = (grid.height + tileSize - 1) / tileSize;
+
+    // Bin triangles by the tiles their pixel bounding boxes overlap
+    std::vector<std::vector<int>> bins(static_cast<size_t>(tilesX) * tilesY);
+    std::vector<int> boxes(triangles.size() * 4);
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        const Point& a = vertices[triangles[i].a];
+        const Point& b = vertices[triangles[i].b];
+        const Point& c = vertices[triangles[i].c];
+        double minX = std::min(a.x, std::min(b.x, c.x)), maxX = std::max(a.x, std::max(b.x, c.x));
+        double minY = std::min(a.y, std::min(b.y, c.y)), maxY = std::max(a.y, std::max(b.y, c.y));
+        double fx0 = std::ceil((minX - grid.originX) / grid.cellWidth - 0.5);
+        double fx1 = std::floor((maxX - grid.originX) / grid.cellWidth - 0.5);
+        double fy0 = std::ceil((minY - grid.originY) / grid.cellHeight - 0.5);
+        double fy1 = std::floor((maxY - grid.originY) / grid.cellHeight - 0.5);
+        if (fx1 < 0 || fy1 < 0 || fx0 > grid.width - 1 || fy0 > grid.height - 1 || fx0 > fx1 || fy0 > fy1) {
+            boxes[i * 4] = 1;
+            boxes[i * 4 + 1] = 0;
+            continue;
+        }
+        int x0 = static_cast<int>(std::max(fx0, 0.0)), x1 = static_cast<int>(std::min(fx1, grid.width - 1.0));
+        int y0 = static_cast<int>(std::max(fy0, 0.0)), y1 = static_cast<int>(std::min(fy1, grid.height - 1.0));
+        boxes[i * 4] = x0;
+        boxes[i * 4 + 1] = x1;
+        boxes[i * 4 + 2] = y0;
+        boxes[i * 4 + 3] = y1;
+        for (int ty = y0 / tileSize; ty <= y1 / tileSize; ++ty) {
+            for (int tx = x0 / tileSize; tx <= x1 / tileSize; ++tx) {
+                bins[static_cast<size_t>(ty) * tilesX + tx].push_back(static_cast<int>(i));
+            }
+        }
+    }
+
+    // Tiles own disjoint pixels, so workers write straight into the caller's buffer
+    parallelFor(bins.size(), numThreads, [&](size_t tile) {
+        int tx0 = static_cast<int>(tile % tilesX) * tileSize;
+        int ty0 = static_cast<int>(tile / tilesX) * tileSize;
+        int tx1 = std::min(tx0 + tileSize, grid.width) - 1;
+        int ty1 = std::min(ty0 + tileSize, grid.height) - 1;
+        for (int i : bins[tile]) {
+            const IndexedTriangle& t = triangles[i];
+            rasterizeTriangleSpan(vertices[t.a], vertices[t.b], vertices[t.c],
+                                  values[t.a], values[t.b], values[t.c], grid,
+                                  std::max(boxes[i * 4], tx0), std::min(boxes[i * 4 + 1], tx1),
+                                  std::max(boxes[i * 4 + 2], ty0), std::min(boxes[i * 4 + 3], ty1), out);
+        }
+    });
+}
+
+// Resample the first scalar attribute channel (e.g. LAS elevation) onto a width x height grid spanning the
+// vertices' bounding box and write it by extension: .pgm as an 8-bit grayscale image scaled to the value range,
+// north up, uncovered pixels black; otherwise raw native-endian float64, row-major from the minimum y, NaN where
+// no triangle covers a pixel.
+bool writeRaster(PointSpan vertices, const std::vector<IndexedTriangle>& triangles,
+                 const PointAttributes& attributes, int width, int height, const std::string& filename) {
+    const AttributeChannel* channel = nullptr;
+    for (const auto& ch : attributes.channels) {
+        if (ch.components == 1) {
+            channel = &ch;
+            break;
+        }
+    }
+    if (!channel || width <= 0 || height <= 0 || vertices.empty()) {
+        std::cerr << "Error: Rasterizing needs a scalar attribute channel (e.g. LAS elevation) and a positive size"
+                  << std::endl;
+        return false;
+    }
+
+    GridSpec grid;
+    double maxX = vertices[0].x, maxY = vertices[0].y;
+    grid.originX = maxX;
+    grid.originY = maxY;
+    for (const auto& p : vertices) {
+        grid.originX = std::min(grid.originX, p.x);
+        grid.originY = std::min(grid.originY, p.y);
+        maxX = std::max(maxX, p.x);
+        maxY = std::max(maxY, p.y);
+    }
+    grid.cellWidth = std::max(maxX - grid.originX, 1e-300) / width;
+    grid.cellHeight = std::max(maxY - grid.originY, 1e-300) / height;
+    grid.width = width;
+    grid.height = height;
+    std::vector<double> pixels(static_cast<size_t>(width) * height, std::numeric_limits<double>::quiet_NaN());
+    rasterizeField(vertices, triangles, channel->values, grid, pixels.data());
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+    if (filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".pgm") == 0) {
+        double low = INFINITY, high = -INFINITY;
+        for (double v : pixels) {
+            if (v == v) {
+                low = std::min(low, v);
+                high = std::max(high, v);
+            }
+        }
+        double scale = high > low ? 254.0 / (high - low) : 0.0;
+        file << "P5\n" << width << " " << height << "\n255\n";
+        std::vector<unsigned char> row(width);
+        for (int y = height - 1; y >= 0; --y) {
+            for (int x = 0; x < width; ++x) {
+                double v = pixels[static_cast<size_t>(y) * width + x];
+                row[x] = v == v ? static_cast<unsigned char>(1 + (v - low) * scale + 0.5) : 0;
+            }
+            file.write(reinterpret_cast<const char*>(row.data()), width);
+        }
+    } else {
+        file.write(reinterpret_cast<const char*>(pixels.data()), pixels.size() * sizeof(double));
+    }
+    if (!file) {
+        std::cerr << "Error: Could not write " << filename << std::endl;
+        return false;
+    }
+    std::cout << "Rasterized " << channel->name << " to " << filename << " (" << width << "x" << height << ")"
+              << std::endl;
+    return true;
+}
+
+// Open-addressing hash map from point coordinates to vertex index
+class PointIndexMap {
+public:
+    explicit PointIndexMap(size_t expected) : size(0), memory(memoryExport) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) capacity <<= 1;
+        keys.resize(capacity);
+        values.assign(capacity, -1);
+        memory.update(capacityBytes(keys) + capacityBytes(values));
+    }
+
+    // Return the index stored for p, or store and return candidate if p is new
+    int findOrInsert(const Point& p, int candidate) {
+        if ((size + 1) * 2 > values.size()) grow();
+        size_t mask = values.size() - 1;
+        for (size_t slot = hash(p) & mask;; slot = (slot + 1) & mask) {
+            if (values[slot] < 0) {
+                keys[slot] = p;
+                values[slot] = candidate;
+                ++size;
+                return candidate;
+            }
+            if (keys[slot] == p) return values[slot];
+        }
+    }
+
+private:
+    static size_t hash(const Point& p) {
+        // +0.0 folds -0.0 into 0.0 so that hashing agrees with Point::operator==
+        double x = p.x + 0.0, y = p.y + 0.0;
+        uint64_t bx, by;
+        std::memcpy(&bx, &x, sizeof(bx));
+        std::memcpy(&by, &y, sizeof(by));
+        uint64_t h = (bx ^ (by * 0x9E3779B97F4A7C15ull)) * 0xBF58476D1CE4E5B9ull;
+        return static_cast<size_t>(h ^ (h >> 31));
+    }
+
+    void grow() {
+        std::vector<Point> oldKeys(keys.size() * 2);
+        std::vector<int> oldValues(values.size() * 2, -1);
+        oldKeys.swap(keys);
+        oldValues.swap(values);
+        size = 0;
+        for (size_t i = 0; i < oldValues.size(); ++i) {
+            if (oldValues[i] >= 0) findOrInsert(oldKeys[i], oldValues[i]);
+        }
+        memory.update(capacityBytes(keys) + capacityBytes(values));
+    }
+
+    std::vector<Point> keys;
+    std::vector<int> values;
+    size_t size;
+    AccountedBytes memory;
+};
+
+// Convert a triangle soup into shared vertices (numbered by first use) and index triangles
+void indexTriangles(const std::vector<Triangle>& triangles, std::vector<Point>& vertices,
+                    std::vector<IndexedTriangle>& indexed) {
+    PointIndexMap pointMap(triangles.size() / 2 + 3);
+    vertices.clear();
+    indexed.clear();
+    indexed.reserve(triangles.size());
+    auto indexOf = [&](const Point& p) {
+        int index = pointMap.findOrInsert(p, static_cast<int>(vertices.size()));
+        if (index == static_cast<int>(vertices.size())) vertices.push_back(p);
+        return index;
+    };
+    for (const auto& tri : triangles) {
+        int a = indexOf(tri.a);
+        int b = indexOf(tri.b);
+        int c = indexOf(tri.c);
+        indexed.push_back({a, b, c});
+    }
+}
+
+// Function to export indexed triangles and per-vertex attributes to a VTK file
+void exportToVTK(PointSpan vertices, const std::vector<IndexedTriangle>& triangles,
+                 const PointAttributes& attributes, const std::string& filename) {
+    std::ofstream vtkFile(filename);
+    if (!vtkFile.is_open()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return;
+    }
+
+    vtkFile << "# vtk DataFile Version 3.0\n";
+    vtkFile << "Delaunay Triangulation\n";
+    vtkFile << "ASCII\n";
+    vtkFile << "DATASET UNSTRUCTURED_GRID\n";
+
+    // Write points
+    vtkFile << "POINTS " << vertices.size() << " float\n";
+    for (const auto& p : vertices) {
+        vtkFile << p.x << " " << p.y << " 0.0\n";
+    }
+
+    // Write triangles (cells)
+    vtkFile << "CELLS " << triangles.size() << " " << triangles.size() * 4 << "\n";
+    for (const auto& tri : triangles) {
+        vtkFile << "3 " << tri.a << " " << tri.b << " " << tri.c << "\n";
+    }
+
+    // Write cell types
+    vtkFile << "CELL_TYPES " << triangles.size() << "\n";
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        vtkFile << "5\n"; // VTK_TRIANGLE
+    }
+
+    // Write attribute channels
+    if (!attributes.channels.empty()) {
+        vtkFile << "POINT_DATA " << vertices.size() << "\n";
+    }
+    for (const auto& ch : attributes.channels) {
+        const int n = ch.components;
+        if (n == 1) {
+            vtkFile << "SCALARS " << ch.name << " double 1\n";
+            vtkFile << "LOOKUP_TABLE default\n";
+            for (size_t v = 0; v < vertices.size(); ++v) {
+                vtkFile << ch.values[v] << "\n";
+            }
+        } else {
+            // VTK vectors are 3D; 2-component channels get a zero z
+            vtkFile << "VECTORS " << ch.name << " double\n";
+            for (size_t v = 0; v < vertices.size(); ++v) {
+                const double* p = &ch.values[v * n];
+                vtkFile << p[0] << " " << p[1] << " " << (n == 3 ? p[2] : 0.0) << "\n";
+            }
+        }
+    }
+
+    vtkFile.close();
+    std::cout << "Exported to " << filename << std::endl;
+}
+
+// Function to export triangles to a VTK file
+void exportToVTK(const std::vector<Triangle>& triangles, const std::string& filename) {
+    std::vector<Point> vertices;
+    std::vector<IndexedTriangle> indexed;
+    indexTriangles(triangles, vertices, indexed);
+    exportToVTK(vertices, indexed, PointAttributes(), filename);
+}
+
+// Large-block file writer: small writes are staged in a buffer, big ones go straight to the file
+class BufferedWriter {
+public:
+    explicit BufferedWriter(const std::string& filename, size_t capacity = 8 << 20)
+        : file(std::fopen(filename.c_str(), "wb")), buffer(capacity), used(0), ok(file != nullptr),
+          memory(memoryExport, capacity) {
+        if (file) std::setvbuf(file, nullptr, _IONBF, 0);
+    }
+    ~BufferedWriter() { close(); }
+
+    bool isOpen() const { return file != nullptr; }
+
+    void write(const void* data, size_t size) {
+        if (used + size > buffer.size()) flush();
+        if (size >= buffer.size()) {
+            if (file && std::fwrite(data, 1, size, file) != size) ok = false;
+            return;
+        }
+        std::memcpy(buffer.data() + used, data, size);
+        used += size;
+    }
+
+    void write(const std::string& text) { write(text.data(), text.size()); }
+
+    // Append a value in big-endian byte order (legacy VTK binary)
+    template <typename T>
+    void writeBigEndian(T value) {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        if (isLittleEndian()) std::reverse(bytes, bytes + sizeof(T));
+        write(bytes, sizeof(T));
+    }
+
+    void flush() {
+        if (file && used > 0 && std::fwrite(buffer.data(), 1, used, file) != used) ok = false;
+        used = 0;
+    }
+
+    // Flush and close; returns false if any write failed
+    bool close() {
+        if (!file) return ok;
+        flush();
+        if (std::fclose(file) != 0) ok = false;
+        file = nullptr;
+        return ok;
+    }
+
+    static bool isLittleEndian() {
+        const uint16_t probe = 1;
+        unsigned char first;
+        std::memcpy(&first, &probe, 1);
+        return first == 1;
+    }
+
+private:
+    std::FILE* file;
+    std::vector<char> buffer;
+    size_t used;
+    bool ok;
+    AccountedBytes memory;
+};
+
+// Function to export indexed triangles and attributes to a legacy BINARY (big-endian) VTK file
+bool exportToVTKBinary(PointSpan vertices, const std::vector<IndexedTriangle>& triangles,
+                       const PointAttributes& attributes, const std::string& filename) {
+    BufferedWriter out(filename);
+    if (!out.isOpen()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+
+    out.write("# vtk DataFile Version 3.0\nDelaunay Triangulation\nBINARY\nDATASET UNSTRUCTURED_GRID\n");
+
+    // All vertices are written as-is; unreferenced points are harmless in VTK
+    out.write("POINTS " + std::to_string(vertices.size()) + " float\n");
+    for (const auto& p : vertices) {
+        out.writeBigEndian(static_cast<float>(p.x));
+        out.writeBigEndian(static_cast<float>(p.y));
+        out.writeBigEndian(0.0f);
+    }
+
+    out.write("\nCELLS " + std::to_string(triangles.size()) + " " + std::to_string(triangles.size() * 4) + "\n");
+    for (const auto& tri : triangles) {
+        out.writeBigEndian(int32_t(3));
+        out.writeBigEndian(int32_t(tri.a));
+        out.writeBigEndian(int32_t(tri.b));
+        out.writeBigEndian(int32_t(tri.c));
+    }
+
+    out.write("\nCELL_TYPES " + std::to_string(triangles.size()) + "\n");
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        out.writeBigEndian(int32_t(5)); // VTK_TRIANGLE
+    }
+    out.write("\n");
+
+    if (!attributes.channels.empty()) {
+        out.write("POINT_DATA " + std::to_string(vertices.size()) + "\n");
+    }
+    for (const auto& ch : attributes.channels) {
+        const int n = ch.components;
+        if (n == 1) {
+            out.write("SCALARS " + ch.name + " double 1\nLOOKUP_TABLE default\n");
+        } else {
+            out.write("VECTORS " + ch.name + " double\n");
+        }
+        for (size_t v = 0; v < vertices.size(); ++v) {
+            for (int k = 0; k < (n == 1 ? 1 : 3); ++k) {
+                out.writeBigEndian(k < n ? ch.values[v * n + k] : 0.0);
+            }
+        }
+        out.write("\n");
+    }
+
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    std::cout << "Exported to " << filename << std::endl;
+    return true;
+}
+
+// Compress one block into the LZ4 block format (greedy single-probe hash matcher, no external library)
+void lz4CompressBlock(const unsigned char* src, size_t n, std::vector<unsigned char>& dst) {
+    const int hashLog = 16;
+    std::vector<int32_t> table(size_t(1) << hashLog, -1);
+    dst.clear();
+    dst.reserve(n + n / 255 + 16);
+
+    auto writeLength = [&](size_t len) {
+        for (; len >= 255; len -= 255) dst.push_back(255);
+        dst.push_back(static_cast<unsigned char>(len));
+    };
+    auto emit = [&](size_t litStart, size_t litLen, size_t offset, size_t matchLen) {
+        unsigned char token = static_cast<unsigned char>(std::min<size_t>(litLen, 15) << 4);
+        if (matchLen) token |= static_cast<unsigned char>(std::min<size_t>(matchLen - 4, 15));
+        dst.push_back(token);
+        if (litLen >= 15) writeLength(litLen - 15);
+        dst.insert(dst.end(), src + litStart, src + litStart + litLen);
+        if (!matchLen) return;
+        dst.push_back(static_cast<unsigned char>(offset & 0xff));
+        dst.push_back(static_cast<unsigned char>(offset >> 8));
+        if (matchLen - 4 >= 15) writeLength(matchLen - 4 - 15);
+    };
+
+    // The format requires the last match to start 12 bytes before the end and the last 5 bytes to be literals
+    size_t anchor = 0;
+    for (size_t i = 0; i + 12 < n;) {
+        uint32_t seq, ref;
+        std::memcpy(&seq, src + i, 4);
+        size_t h = (seq * 2654435761u) >> (32 - hashLog);
+        int32_t candidate = table[h];
+        table[h] = static_cast<int32_t>(i);
+        if (candidate >= 0 && i - candidate <= 65535) {
+            std::memcpy(&ref, src + candidate, 4);
+            if (ref == seq) {
+                size_t len = 4;
+                size_t maxLen = n - 5 - i;
+                while (len < maxLen && src[candidate + len] == src[i + len]) ++len;
+                emit(anchor, i - anchor, i - candidate, len);
+                i += len;
+                anchor = i;
+                continue;
+            }
+        }
+        ++i;
+    }
+    emit(anchor, n - anchor, 0, 0);
+}
+
+// One DataArray of a VTU file; fill(first, count, dst) writes elements [first, first + count) as raw bytes
+struct VTUArray {
+    std::string attributes;
+    size_t elementSize;
+    size_t count;
+    std::function<void(size_t, size_t, char*)> fill;
+};
+
+// Function to export indexed triangles and attributes to a VTU file with raw appended data.
+// With compress set, arrays are split into blocks and LZ4-compressed in parallel (vtkLZ4DataCompressor).
+bool exportToVTU(PointSpan vertices, const std::vector<IndexedTriangle>& triangles,
+                 const PointAttributes& attributes, const std::string& filename, bool compress = false) {
+    BufferedWriter out(filename);
+    if (!out.isOpen()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+
+    // Block size is a multiple of every element size used below (1, 4, 8 and 24 bytes)
+    const size_t blockBytes = 3 << 18;
+
+    std::vector<VTUArray> pointData;
+    for (const auto& ch : attributes.channels) {
+        const AttributeChannel* c = &ch;
+        pointData.push_back({"type=\"Float64\" Name=\"" + ch.name + "\" NumberOfComponents=\"" +
+                                 std::to_string(ch.components) + "\"",
+                             sizeof(double) * ch.components, vertices.size(),
+                             [c](size_t first, size_t count, char* dst) {
+                                 std::memcpy(dst, c->values.data() + first * c->components,
+                                             count * c->components * sizeof(double));
+                             }});
+    }
+    std::vector<VTUArray> geometry = {
+        {"type=\"Float64\" NumberOfComponents=\"3\"", 3 * sizeof(double), vertices.size(),
+         [&](size_t first, size_t count, char* dst) {
+             double* d = reinterpret_cast<double*>(dst);
+             for (size_t i = 0; i < count; ++i) {
+                 d[3 * i] = vertices[first + i].x;
+                 d[3 * i + 1] = vertices[first + i].y;
+                 d[3 * i + 2] = 0.0;
+             }
+         }},
+        // IndexedTriangle is three packed ints, i.e. already the connectivity layout
+        {"type=\"Int32\" Name=\"connectivity\"", sizeof(int32_t), triangles.size() * 3,
+         [&](size_t first, size_t count, char* dst) {
+             std::memcpy(dst, reinterpret_cast<const int32_t*>(triangles.data()) + first, count * sizeof(int32_t));
+         }},
+        {"type=\"Int64\" Name=\"offsets\"", sizeof(int64_t), triangles.size(),
+         [](size_t first, size_t count, char* dst) {
+             int64_t* d = reinterpret_cast<int64_t*>(dst);
+             for (size_t i = 0; i < count; ++i) d[i] = static_cast<int64_t>(first + i + 1) * 3;
+         }},
+        {"type=\"UInt8\" Name=\"types\"", 1, triangles.size(),
+         [](size_t, size_t count, char* dst) { std::memset(dst, 5, count); }}, // VTK_TRIANGLE
+    };
+    static_assert(sizeof(IndexedTriangle) == 3 * sizeof(int32_t), "IndexedTriangle must be packed");
+
+    // Compressed arrays must be fully encoded up front because the XML header carries their offsets
+    std::vector<VTUArray*> arrays;
+    for (auto& a : pointData) arrays.push_back(&a);
+    for (auto& a : geometry) arrays.push_back(&a);
+    std::vector<std::vector<uint64_t>> headers(arrays.size());
+    std::vector<std::vector<std::vector<unsigned char>>> blocks(arrays.size());
+    std::vector<uint64_t> offsets(arrays.size());
+    uint64_t appendedSize = 0;
+    for (size_t i = 0; i < arrays.size(); ++i) {
+        const VTUArray& a = *arrays[i];
+        uint64_t bytes = a.count * a.elementSize;
+        if (compress) {
+            size_t numBlocks = (bytes + blockBytes - 1) / blockBytes;
+            blocks[i].resize(numBlocks);
+            parallelFor(numBlocks, 0, [&](size_t b) {
+                size_t first = b * blockBytes / a.elementSize;
+                size_t count = std::min(blockBytes / a.elementSize, a.count - first);
+                std::vector<char> raw(count * a.elementSize);
+                a.fill(first, count, raw.data());
+                lz4CompressBlock(reinterpret_cast<unsigned char*>(raw.data()), raw.size(), blocks[i][b]);
+            });
+            headers[i] = {numBlocks, blockBytes, bytes % blockBytes};
+            for (const auto& blk : blocks[i]) headers[i].push_back(blk.size());
+        } else {
+            headers[i] = {bytes};
+        }
+        offsets[i] = appendedSize;
+        appendedSize += headers[i].size() * sizeof(uint64_t);
+        if (compress) {
+            for (size_t b = 3; b < headers[i].size(); ++b) appendedSize += headers[i][b];
+        } else {
+            appendedSize += bytes;
+        }
+    }
+
+    std::ostringstream xml;
+    xml << "<?xml version=\"1.0\"?>\n";
+    xml << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+        << (BufferedWriter::isLittleEndian() ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\""
+        << (compress ? " compressor=\"vtkLZ4DataCompressor\"" : "") << ">\n";
+    xml << "  <UnstructuredGrid>\n";
+    xml << "    <Piece NumberOfPoints=\"" << vertices.size() << "\" NumberOfCells=\"" << triangles.size() << "\">\n";
+    size_t index = 0;
+    auto dataArray = [&](const char* indent) {
+        xml << indent << "<DataArray " << arrays[index]->attributes << " format=\"appended\" offset=\""
+            << offsets[index] << "\"/>\n";
+        ++index;
+    };
+    if (!pointData.empty()) {
+        xml << "      <PointData>\n";
+        for (size_t i = 0; i < pointData.size(); ++i) dataArray("        ");
+        xml << "      </PointData>\n";
+    }
+    xml << "      <Points>\n";
+    dataArray("        ");
+    xml << "      </Points>\n";
+    xml << "      <Cells>\n";
+    for (int i = 0; i < 3; ++i) dataArray("        ");
+    xml << "      </Cells>\n";
+    xml << "    </Piece>\n";
+    xml << "  </UnstructuredGrid>\n";
+    xml << "  <AppendedData encoding=\"raw\">\n   _";
+    out.write(xml.str());
+
+    std::vector<char> chunk;
+    for (size_t i = 0; i < arrays.size(); ++i) {
+        const VTUArray& a = *arrays[i];
+        out.write(headers[i].data(), headers[i].size() * sizeof(uint64_t));
+        if (compress) {
+            for (const auto& blk : blocks[i]) out.write(blk.data(), blk.size());
+            continue;
+        }
+        const size_t perChunk = blockBytes / a.elementSize;
+        chunk.resize(blockBytes);
+        for (size_t first = 0; first < a.count; first += perChunk) {
+            size_t count = std::min(perChunk, a.count - first);
+            a.fill(first, count, chunk.data());
+            out.write(chunk.data(), count * a.elementSize);
+        }
+    }
+    out.write("\n  </AppendedData>\n</VTKFile>\n");
+
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    std::cout << "Exported to " << filename << std::endl;
+    return true;
+}
+
+// Append a double formatted like std::ostream's default (printf "%g")
+static void appendGeneral(std::string& out, double value) {
+    char buf[32];
+#if defined(__cpp_lib_to_chars)
+    size_t len = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::general, 6).ptr - buf;
+#else
+    size_t len = static_cast<size_t>(std::snprintf(buf, sizeof(buf), "%g", value));
+#endif
+    out.append(buf, len);
+}
+
+// Append a non-negative integer in decimal
+static void appendInteger(std::string& out, unsigned long long value) {
+    char buf[24];
+    char* p = buf + sizeof(buf);
+    do {
+        *--p = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value);
+    out.append(p, buf + sizeof(buf) - p);
+}
+
+// Write buffers to a file in order, using writev where available
+static bool writeBuffers(const std::string& filename, const std::vector<std::string>& buffers) {
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+#if defined(IOV_MAX)
+    const size_t maxVectors = IOV_MAX;
+#else
+    const size_t maxVectors = 1024;
+#endif
+    std::vector<iovec> vectors;
+    for (const auto& b : buffers) {
+        if (!b.empty()) vectors.push_back({const_cast<char*>(b.data()), b.size()});
+    }
+    bool ok = true;
+    for (size_t i = 0; i < vectors.size() && ok;) {
+        ssize_t written = ::writev(fd, &vectors[i], static_cast<int>(std::min(maxVectors, vectors.size() - i)));
+        if (written < 0) {
+            ok = false;
+            break;
+        }
+        // Skip fully written buffers and advance into a partially written one
+        for (size_t rest = static_cast<size_t>(written); i < vectors.size() && rest > 0;) {
+            if (rest >= vectors[i].iov_len) {
+                rest -= vectors[i].iov_len;
+                ++i;
+            } else {
+                vectors[i].iov_base = static_cast<char*>(vectors[i].iov_base) + rest;
+                vectors[i].iov_len -= rest;
+                rest = 0;
+            }
+        }
+    }
+    if (::close(fd) != 0) ok = false;
+    return ok;
+#else
+    BufferedWriter out(filename);
+    for (const auto& b : buffers) out.write(b);
+    return out.close();
+#endif
+}
+
+// Function to export indexed triangles and attributes to an ASCII VTK file, formatting chunks in parallel.
+// The output is byte-for-byte identical to exportToVTK.
+bool exportToVTKParallel(PointSpan vertices, const std::vector<IndexedTriangle>& triangles,
+                         const PointAttributes& attributes, const std::string& filename,
+                         unsigned numThreads = 0) {
+    const size_t chunkRows = 1 << 16;
+
+    // Each job formats one section header or one chunk of rows into its own buffer
+    std::vector<std::function<void(std::string&)>> jobs;
+    auto addText = [&](const std::string& text) {
+        jobs.push_back([text](std::string& out) { out = text; });
+    };
+    auto addRows = [&](size_t count, std::function<void(std::string&, size_t)> row) {
+        for (size_t first = 0; first < count; first += chunkRows) {
+            size_t last = std::min(count, first + chunkRows);
+            jobs.push_back([first, last, row](std::string& out) {
+                out.reserve((last - first) * 24);
+                for (size_t i = first; i < last; ++i) row(out, i);
+            });
+        }
+    };
+
+    addText("# vtk DataFile Version 3.0\nDelaunay Triangulation\nASCII\nDATASET UNSTRUCTURED_GRID\n"
+            "POINTS " + std::to_string(vertices.size()) + " float\n");
+    addRows(vertices.size(), [&](std::string& out, size_t i) {
+        appendGeneral(out, vertices[i].x);
+        out += ' ';
+        appendGeneral(out, vertices[i].y);
+        out += " 0.0\n";
+    });
+
+    addText("CELLS " + std::to_string(triangles.size()) + " " + std::to_string(triangles.size() * 4) + "\n");
+    addRows(triangles.size(), [&](std::string& out, size_t i) {
+        out += "3 ";
+        appendInteger(out, triangles[i].a);
+        out += ' ';
+        appendInteger(out, triangles[i].b);
+        out += ' ';
+        appendInteger(out, triangles[i].c);
+        out += '\n';
+    });
+
+    addText("CELL_TYPES " + std::to_string(triangles.size()) + "\n");
+    addRows(triangles.size(), [](std::string& out, size_t) { out += "5\n"; });
+
+    if (!attributes.channels.empty()) {
+        addText("POINT_DATA " + std::to_string(vertices.size()) + "\n");
+    }
+    for (const auto& ch : attributes.channels) {
+        const AttributeChannel* c = &ch;
+        if (ch.components == 1) {
+            addText("SCALARS " + ch.name + " double 1\nLOOKUP_TABLE default\n");
+            addRows(vertices.size(), [c](std::string& out, size_t v) {
+                appendGeneral(out, c->values[v]);
+                out += '\n';
+            });
+        } else {
+            addText("VECTORS " + ch.name + " double\n");
+            addRows(vertices.size(), [c](std::string& out, size_t v) {
+                const double* p = &c->values[v * c->components];
+                appendGeneral(out, p[0]);
+                out += ' ';
+                appendGeneral(out, p[1]);
+                out += ' ';
+                appendGeneral(out, c->components == 3 ? p[2] : 0.0);
+                out += '\n';
+            });
+        }
+    }
+
+    std::vector<std::string> buffers(jobs.size());
+    parallelFor(jobs.size(), numThreads, [&](size_t i) { jobs[i](buffers[i]); });
+    size_t bufferBytes = 0;
+    for (const auto& b : buffers) bufferBytes += b.capacity();
+    AccountedBytes bufferMemory(memoryExport, bufferBytes);
+
+    if (!writeBuffers(filename, buffers)) {
+        std::cerr << "Error: Could not write file " << filename << std::endl;
+        return false;
+    }
+    std::cout << "Exported to " << filename << std::endl;
+    return true;
+}
+
+// Read-only view of a whole file: memory-mapped on POSIX, read into an aligned buffer elsewhere
+class MappedFile {
+public:
+    MappedFile() : base(nullptr), length(0), mapped(false) {}
+    ~MappedFile() { close(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& filename) {
+        close();
+#if defined(__unix__) || defined(__APPLE__)
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        length = static_cast<size_t>(info.st_size);
+        if (length > 0) {
+            void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address == MAP_FAILED) {
+                ::close(fd);
+                length = 0;
+                return false;
+            }
+            ::madvise(address, length, MADV_SEQUENTIAL);
+            base = static_cast<const char*>(address);
+            mapped = true;
+        }
+        ::close(fd);
+        return true;
+#else
+        std::ifstream in(filename, std::ios::binary | std::ios::ate);
+        if (!in.is_open()) return false;
+        length = static_cast<size_t>(in.tellg());
+        fallback.resize((length + sizeof(double) - 1) / sizeof(double));
+        in.seekg(0);
+        in.read(reinterpret_cast<char*>(fallback.data()), length);
+        base = reinterpret_cast<const char*>(fallback.data());
+        return static_cast<bool>(in);
+#endif
+    }
+
+    void close() {
+#if defined(__unix__) || defined(__APPLE__)
+        if (mapped) ::munmap(const_cast<char*>(base), length);
+#endif
+        fallback.clear();
+        base = nullptr;
+        length = 0;
+        mapped = false;
+    }
+
+    const char* data() const { return base; }
+    size_t size() const { return length; }
+
+private:
+    const char* base;
+    size_t length;
+    bool mapped;
+    std::vector<double> fallback;
+};
+
+// Point cloud loaded from disk; binary inputs in native layout alias the mapped file instead of being copied
+class PointCloud {
+public:
+    PointCloud() : view(nullptr), count(0), memory(memoryPoints) {}
+
+    PointSpan points() const { return view ? PointSpan(view, count) : PointSpan(storage); }
+
+    MappedFile file;
+    std::vector<Point> storage;
+    const Point* view;
+    size_t count;
+    PointAttributes attributes;
+    AccountedBytes memory;  // owned storage and attribute channels (a mapping is not counted)
+};
+
+static_assert(sizeof(Point) == 2 * sizeof(double), "Point must match the double[2] file layout");
+
+// Parse a decimal floating-point number in [p, end); returns the position after it or nullptr.
+// Numbers with at most 19 significant digits and small exponents take an exact fast path; the rest go to strtod.
+static const char* parseDouble(const char* p, const char* end, double& value) {
+    static const double powers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    const char* start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')) negative = *p++ == '-';
+
+    uint64_t mantissa = 0;
+    int significant = 0, exponent = 0;
+    bool anyDigits = false, truncated = false;
+    for (; p < end && *p >= '0' && *p <= '9'; ++p) {
+        anyDigits = true;
+        if (significant < 19) {
+            mantissa = mantissa * 10 + (*p - '0');
+            if (mantissa) ++significant;
+        } else {
+            ++exponent;
+            truncated = true;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (++p; p < end && *p >= '0' && *p <= '9'; ++p) {
+            anyDigits = true;
+            if (significant < 19) {
+                mantissa = mantissa * 10 + (*p - '0');
+                if (mantissa) ++significant;
+                --exponent;
+            } else {
+                truncated = true;
+            }
+        }
+    }
+    if (!anyDigits) return nullptr;
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        bool negativeExponent = false;
+        if (q < end && (*q == '-' || *q == '+')) negativeExponent = *q++ == '-';
+        if (q < end && *q >= '0' && *q <= '9') {
+            int e = 0;
+            for (; q < end && *q >= '0' && *q <= '9'; ++q) e = std::min(e * 10 + (*q - '0'), 100000);
+            exponent += negativeExponent ? -e : e;
+            p = q;
+        }
+    }
+
+    if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+        double m = static_cast<double>(mantissa);
+        value = exponent < 0 ? m / powers[-exponent] : m * powers[exponent];
+        if (negative) value = -value;
+        return p;
+    }
+    std::string token(start, p);
+    value = std::strtod(token.c_str(), nullptr);
+    return p;
+}
+
+// Parse the points of complete lines in [begin, end); lines whose first two fields are not numbers are skipped
+static void parsePointLines(const char* begin, const char* end, std::vector<Point>& out) {
+    auto isSeparator = [](char c) { return c == ' ' || c == '\t' || c == ',' || c == ';' || c == '\r'; };
+    for (const char* line = begin; line < end;) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        if (!lineEnd) lineEnd = end;
+        const char* p = line;
+        while (p < lineEnd && isSeparator(*p)) ++p;
+        Point point;
+        p = p < lineEnd ? parseDouble(p, lineEnd, point.x) : nullptr;
+        if (p && p < lineEnd && isSeparator(*p)) {
+            while (p < lineEnd && isSeparator(*p)) ++p;
+            p = parseDouble(p, lineEnd, point.y);
+            if (p && (p == lineEnd || isSeparator(*p))) out.push_back(point);
+        }
+        line = lineEnd + 1;
+    }
+}
+
+// Read an XYZ/CSV text file ("x y [z ...]" per line, whitespace, comma or semicolon separated).
+// The mapped file is split at line boundaries into chunks that are parsed in parallel.
+bool readPointsText(const std::string& filename, PointCloud& cloud, unsigned numThreads = 0) {
+    if (!cloud.file.open(filename)) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+    const char* data = cloud.file.data();
+    const size_t size = cloud.file.size();
+    const size_t chunkBytes = 4 << 20;
+    const size_t numChunks = std::max<size_t>(1, size / chunkBytes);
+
+    auto chunkStart = [&](size_t k) -> size_t {
+        if (k == 0) return 0;
+        if (k >= numChunks) return size;
+        const char* nl = static_cast<const char*>(std::memchr(data + k * (size / numChunks), '\n',
+                                                              size - k * (size / numChunks)));
+        return nl ? static_cast<size_t>(nl - data) + 1 : size;
+    };
+    std::vector<std::vector<Point>> parts(numChunks);
+    parallelFor(numChunks, numThreads, [&](size_t k) {
+        size_t first = chunkStart(k), last = std::max(first, chunkStart(k + 1));
+        parts[k].reserve((last - first) / 16);
+        parsePointLines(data + first, data + last, parts[k]);
+    });
+
+    std::vector<size_t> offsets(numChunks + 1, 0);
+    for (size_t k = 0; k < numChunks; ++k) offsets[k + 1] = offsets[k] + parts[k].size();
+    cloud.storage.resize(offsets[numChunks]);
+    parallelFor(numChunks, numThreads, [&](size_t k) {
+        std::copy(parts[k].begin(), parts[k].end(), cloud.storage.begin() + offsets[k]);
+        std::vector<Point>().swap(parts[k]);
+    });
+    cloud.view = nullptr;
+    cloud.count = cloud.storage.size();
+    cloud.file.close();
+    return true;
+}
+
+// Read a raw file of native-endian double[2] records; the points alias the mapping without a copy
+bool readPointsRaw(const std::string& filename, PointCloud& cloud) {
+    if (!cloud.file.open(filename)) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+    if (cloud.file.size() % sizeof(Point) != 0) {
+        std::cerr << "Error: " << filename << " is not a whole number of double[2] records" << std::endl;
+        return false;
+    }
+    cloud.storage.clear();
+    cloud.view = reinterpret_cast<const Point*>(cloud.file.data());
+    cloud.count = cloud.file.size() / sizeof(Point);
+    return true;
+}
+
+// Read the x and y properties of the vertex element of a binary PLY file.
+// A vertex record of exactly little-endian "double x, double y" is used in place; other layouts are decoded in parallel.
+bool readPointsPLY(const std::string& filename, PointCloud& cloud, unsigned numThreads = 0) {
+    if (!cloud.file.open(filename)) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+    const char* data = cloud.file.data();
+    const size_t size = cloud.file.size();
+    const char* marker = "end_header\n";
+    const char* headerEnd = std::search(data, data + size, marker, marker + std::strlen(marker));
+    if (size < 4 || std::memcmp(data, "ply", 3) != 0 || headerEnd == data + size) {
+        std::cerr << "Error: " << filename << " is not a PLY file" << std::endl;
+        return false;
+    }
+    const size_t bodyOffset = headerEnd - data + std::strlen(marker);
+
+    std::istringstream header(std::string(data, headerEnd));
+    std::string line, format;
+    size_t vertexCount = 0, stride = 0;
+    int xOffset = -1, yOffset = -1;
+    std::string xType, yType;
+    bool inVertex = false, sawElement = false;
+    while (std::getline(header, line)) {
+        std::istringstream words(line);
+        std::string keyword;
+        words >> keyword;
+        if (keyword == "format") {
+            words >> format;
+        } else if (keyword == "element") {
+            std::string name;
+            size_t n = 0;
+            words >> name >> n;
+            if (!sawElement && name != "vertex") {
+                std::cerr << "Error: " << filename << " must list the vertex element first" << std::endl;
+                return false;
+            }
+            inVertex = !sawElement;
+            sawElement = true;
+            if (inVertex) vertexCount = n;
+        } else if (keyword == "property" && inVertex) {
+            std::string type, name;
+            words >> type >> name;
+            size_t width = type == "char" || type == "uchar" || type == "int8" || type == "uint8" ? 1
+                         : type == "short" || type == "ushort" || type == "int16" || type == "uint16" ? 2
+                         : type == "int" || type == "uint" || type == "int32" || type == "uint32" ||
+                           type == "float" || type == "float32" ? 4
+                         : type == "double" || type == "float64" ? 8 : 0;
+            if (width == 0) {
+                std::cerr << "Error: Unsupported PLY vertex property '" << line << "'" << std::endl;
+                return false;
+            }
+            if (name == "x") { xOffset = static_cast<int>(stride); xType = type; }
+            if (name == "y") { yOffset = static_cast<int>(stride); yType = type; }
+            stride += width;
+        }
+    }
+    bool littleEndian = format == "binary_little_endian";
+    if ((!littleEndian && format != "binary_big_endian") || xOffset < 0 || yOffset < 0) {
+        std::cerr << "Error: " << filename << " needs a binary PLY vertex element with x and y" << std::endl;
+        return false;
+    }
+    // Divide rather than multiply so that a huge vertex count cannot wrap past the check
+    if (bodyOffset > size || vertexCount > (size - bodyOffset) / stride) {
+        std::cerr << "Error: " << filename << " is truncated" << std::endl;
+        return false;
+    }
+    const char* body = data + bodyOffset;
+
+    bool nativeOrder = littleEndian == BufferedWriter::isLittleEndian();
+    if (nativeOrder && stride == sizeof(Point) && xOffset == 0 && yOffset == 8 &&
+        (xType == "double" || xType == "float64") && (yType == "double" || yType == "float64") &&
+        reinterpret_cast<uintptr_t>(body) % alignof(Point) == 0) {
+        cloud.storage.clear();
+        cloud.view = reinterpret_cast<const Point*>(body);
+        cloud.count = vertexCount;
+        return true;
+    }
+
+    auto decode = [nativeOrder](const char* p, const std::string& type) -> double {
+        unsigned char bytes[8];
+        size_t width = type == "double" || type == "float64" ? 8 : type == "float" || type == "float32" ? 4
+                     : type == "int" || type == "uint" || type == "int32" || type == "uint32" ? 4
+                     : type == "short" || type == "ushort" || type == "int16" || type == "uint16" ? 2 : 1;
+        std::memcpy(bytes, p, width);
+        if (!nativeOrder) std::reverse(bytes, bytes + width);
+        if (width == 8) { double v; std::memcpy(&v, bytes, 8); return v; }
+        if (type == "float" || type == "float32") { float v; std::memcpy(&v, bytes, 4); return v; }
+        if (width == 4) {
+            if (type[0] == 'u') { uint32_t v; std::memcpy(&v, bytes, 4); return v; }
+            int32_t v; std::memcpy(&v, bytes, 4); return v;
+        }
+        if (width == 2) {
+            if (type[0] == 'u') { uint16_t v; std::memcpy(&v, bytes, 2); return v; }
+            int16_t v; std::memcpy(&v, bytes, 2); return v;
+        }
+        return type[0] == 'u' ? static_cast<double>(static_cast<unsigned char>(bytes[0]))
+                              : static_cast<double>(static_cast<signed char>(bytes[0]));
+    };
+    cloud.storage.resize(vertexCount);
+    const size_t chunk = 1 << 16;
+    parallelFor((vertexCount + chunk - 1) / chunk, numThreads, [&](size_t k) {
+        for (size_t i = k * chunk; i < std::min(vertexCount, (k + 1) * chunk); ++i) {
+            const char* record = body + i * stride;
+            cloud.storage[i] = {decode(record + xOffset, xType), decode(record + yOffset, yType)};
+        }
+    });
+    cloud.view = nullptr;
+    cloud.count = vertexCount;
+    cloud.file.close();
+    return true;
+}
+
+// Read a little-endian value from unaligned bytes
+template <typename T>
+static T readLittleEndian(const char* p) {
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, p, sizeof(T));
+    if (!BufferedWriter::isLittleEndian()) std::reverse(bytes, bytes + sizeof(T));
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+// Options for LAS ingestion
+struct LASOptions {
+    std::vector<int> classes;   // classifications to keep (e.g. 2 = ground); empty keeps every point
+    size_t thinStep;            // keep every thinStep-th accepted point
+    bool withElevation;         // store Z as the "elevation" attribute channel
+
+    LASOptions() : thinStep(1), withElevation(true) {}
+};
+
+// Read an uncompressed LAS 1.2-1.4 file (point formats 0-10). Scaled integer coordinates are decoded
+// in parallel straight into the cloud's point storage; a counting pass sizes it exactly up front.
+bool readPointsLAS(const std::string& filename, PointCloud& cloud, const LASOptions& options = LASOptions(),
+                   unsigned numThreads = 0) {
+    if (!cloud.file.open(filename)) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+    const char* data = cloud.file.data();
+    const size_t size = cloud.file.size();
+    if (size < 227 || std::memcmp(data, "LASF", 4) != 0) {
+        std::cerr << "Error: " << filename << " is not a LAS file" << std::endl;
+        return false;
+    }
+
+    int versionMinor = static_cast<unsigned char>(data[25]);
+    uint16_t headerSize = readLittleEndian<uint16_t>(data + 94);
+    uint32_t pointOffset = readLittleEndian<uint32_t>(data + 96);
+    unsigned char formatByte = static_cast<unsigned char>(data[104]);
+    uint16_t recordLength = readLittleEndian<uint16_t>(data + 105);
+    uint64_t recordCount = readLittleEndian<uint32_t>(data + 107);
+    if (versionMinor >= 4 && headerSize >= 375 && size >= 255) {
+        uint64_t extendedCount = readLittleEndian<uint64_t>(data + 247);
+        if (extendedCount) recordCount = extendedCount;
+    }
+    int format = formatByte & 0x3f;
+    if ((formatByte & 0x80) || format > 10) {
+        std::cerr << "Error: " << filename << " uses a compressed or unknown point format" << std::endl;
+        return false;
+    }
+    const bool extended = format >= 6;
+    // Divides rather than multiplies, so a huge (LAS 1.4 64-bit) record count cannot wrap
+    if (recordLength < (extended ? 30 : 20) || pointOffset > size ||
+        recordCount > (size - pointOffset) / recordLength) {
+        std::cerr << "Error: " << filename << " has an invalid point record layout" << std::endl;
+        return false;
+    }
+    const double scale[3] = {readLittleEndian<double>(data + 131), readLittleEndian<double>(data + 139),
+                             readLittleEndian<double>(data + 147)};
+    const double offset[3] = {readLittleEndian<double>(data + 155), readLittleEndian<double>(data + 163),
+                              readLittleEndian<double>(data + 171)};
+
+    bool keepClass[256];
+    std::fill(keepClass, keepClass + 256, options.classes.empty());
+    for (int c : options.classes) {
+        if (c >= 0 && c < 256) keepClass[c] = true;
+    }
+    const char* records = data + pointOffset;
+    auto accepted = [&](const char* record) {
+        unsigned char c = static_cast<unsigned char>(extended ? record[16] : record[15] & 0x1f);
+        return keepClass[c];
+    };
+
+    // Pass 1 counts accepted points per chunk so that pass 2 can write each chunk to its final position
+    const size_t chunk = 1 << 18;
+    const size_t numChunks = static_cast<size_t>((recordCount + chunk - 1) / chunk);
+    std::vector<size_t> acceptedBefore(numChunks + 1, 0);
+    parallelFor(numChunks, numThreads, [&](size_t k) {
+        size_t n = 0;
+        for (size_t i = k * chunk; i < std::min<size_t>(recordCount, (k + 1) * chunk); ++i) {
+            n += accepted(records + i * recordLength);
+        }
+        acceptedBefore[k + 1] = n;
+    });
+    for (size_t k = 0; k < numChunks; ++k) acceptedBefore[k + 1] += acceptedBefore[k];
+
+    const size_t step = std::max<size_t>(1, options.thinStep);
+    auto keptBefore = [&](size_t acceptedIndex) { return (acceptedIndex + step - 1) / step; };
+    const size_t kept = keptBefore(acceptedBefore[numChunks]);
+    cloud.storage.resize(kept);
+    std::vector<double> elevation(options.withElevation ? kept : 0);
+
+    parallelFor(numChunks, numThreads, [&](size_t k) {
+        size_t acceptedIndex = acceptedBefore[k];
+        size_t out = keptBefore(acceptedIndex);
+        for (size_t i = k * chunk; i < std::min<size_t>(recordCount, (k + 1) * chunk); ++i) {
+            const char* record = records + i * recordLength;
+            if (!accepted(record)) continue;
+            if (acceptedIndex++ % step != 0) continue;
+            cloud.storage[out] = {readLittleEndian<int32_t>(record) * scale[0] + offset[0],
+                                  readLittleEndian<int32_t>(record + 4) * scale[1] + offset[1]};
+            if (options.withElevation) {
+                elevation[out] = readLittleEndian<int32_t>(record + 8) * scale[2] + offset[2];
+            }
+            ++out;
+        }
+    });
+
+    cloud.view = nullptr;
+    cloud.count = kept;
+    if (options.withElevation) cloud.attributes.add("elevation", 1, std::move(elevation), kept);
+    cloud.file.close();
+    return true;
+}
+
+// Load a point cloud, choosing the reader from the file extension (.las, .ply, .bin/.raw, otherwise text)
+bool loadPointCloud(const std::string& filename, PointCloud& cloud, unsigned numThreads = 0) {
+    TRACE_SCOPE("load");
+    std::string ext = filename.substr(filename.find_last_of('.') == std::string::npos ? filename.size()
+                                                                                      : filename.find_last_of('.'));
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+    bool ok;
+    if (ext == ".las") {
+        ok = readPointsLAS(filename, cloud, LASOptions(), numThreads);
+    } else if (ext == ".ply") {
+        ok = readPointsPLY(filename, cloud, numThreads);
+    } else if (ext == ".bin" || ext == ".raw") {
+        ok = readPointsRaw(filename, cloud);
+    } else {
+        ok = readPointsText(filename, cloud, numThreads);
+    }
+    size_t bytes = capacityBytes(cloud.storage);
+    for (const auto& channel : cloud.attributes.channels) bytes += capacityBytes(channel.values);
+    cloud.memory.update(bytes);
+    return ok;
+}
+
+// Options for out-of-core streaming triangulation
+struct StreamingOptions {
+    size_t maxPointsPerColumn;  // target points resident per sweep column, raised if needed to honour maxColumns
+    size_t maxColumns;          // cap on simultaneously open column files
+
+    StreamingOptions() : maxPointsPerColumn(1 << 20), maxColumns(256) {}
+};
+
+// Statistics of a streaming run
+struct StreamingStats {
+    size_t points;
+    size_t triangles;
+    size_t columns;
+    size_t peakActiveTriangles;
+};
+
+// Triangle still open to change during a streaming sweep, with its global vertex ids and cached circumcircle
+struct ActiveTriangle {
+    int64_t ids[3];
+    Triangle t;
+    double cx, cy, r2;
+};
+
+// Compute the circumcircle of t (infinite radius for degenerate triangles)
+static void circumcircle(const Triangle& t, double& cx, double& cy, double& r2) {
+    double d = 2 * (t.a.x * (t.b.y - t.c.y) + t.b.x * (t.c.y - t.a.y) + t.c.x * (t.a.y - t.b.y));
+    if (d == 0) {
+        cx = cy = 0;
+        r2 = INFINITY;
+        return;
+    }
+    double a2 = t.a.x * t.a.x + t.a.y * t.a.y;
+    double b2 = t.b.x * t.b.x + t.b.y * t.b.y;
+    double c2 = t.c.x * t.c.x + t.c.y * t.c.y;
+    cx = (a2 * (t.b.y - t.c.y) + b2 * (t.c.y - t.a.y) + c2 * (t.a.y - t.b.y)) / d;
+    cy = (a2 * (t.c.x - t.b.x) + b2 * (t.a.x - t.c.x) + c2 * (t.b.x - t.a.x)) / d;
+    r2 = (t.a.x - cx) * (t.a.x - cx) + (t.a.y - cy) * (t.a.y - cy);
+}
+
+// Out-of-core Delaunay triangulation by a left-to-right sweep with spatial finalization.
+// Points are bucketed into x-columns of roughly maxPointsPerColumn points (temporary files next to the output),
+// then inserted column by column. Once a column is done no later point lies left of its right edge, so every
+// triangle whose circumcircle ends before that edge is final: it is written out and dropped from memory.
+// Resident memory is the current column plus the sweep front, not n.
+// Output: <prefix>.vertices (double[2] in insertion order, readable by readPointsRaw) and
+// <prefix>.triangles (int64 vertex-id triples into that vertex file).
+bool streamingDelaunayTriangulation(PointSpan points, const std::string& outputPrefix,
+                                    const StreamingOptions& options = StreamingOptions(),
+                                    StreamingStats* stats = nullptr) {
+    const size_t n = points.size();
+    if (n == 0) {
+        std::cerr << "Error: No points to triangulate" << std::endl;
+        return false;
+    }
+
+    // Pass 1: bounds and a fine x-histogram used to place column boundaries at point quantiles
+    double minX = points[0].x, minY = points[0].y, maxX = minX, maxY = minY;
+    for (const auto& p : points) {
+        minX = std::min(minX, p.x);
+        minY = std::min(minY, p.y);
+        maxX = std::max(maxX, p.x);
+        maxY = std::max(maxY, p.y);
+    }
+    const size_t bins = 1 << 16;
+    const double binWidth = maxX > minX ? (maxX - minX) / bins : 1.0;
+    auto binOf = [&](double x) { return std::min(bins - 1, static_cast<size_t>((x - minX) / binWidth)); };
+    std::vector<size_t> histogram(bins, 0);
+    for (const auto& p : points) ++histogram[binOf(p.x)];
+
+    // Greedy quantile split; a heavy bin closes a column early, so a split can reach about twice n / target
+    // columns, and the target grows until the column files fit under maxColumns
+    size_t target = std::max(n / std::max<size_t>(1, options.maxColumns) + 1, options.maxPointsPerColumn);
+    std::vector<size_t> columnOfBin(bins);
+    size_t numColumns;
+    do {
+        numColumns = 1;
+        size_t filled = 0;
+        for (size_t b = 0; b < bins; ++b) {
+            if (filled > 0 && filled + histogram[b] > target) {
+                ++numColumns;
+                filled = 0;
+            }
+            columnOfBin[b] = numColumns - 1;
+            filled += histogram[b];
+        }
+        target += target / 2 + 1;
+    } while (numColumns > std::max<size_t>(1, options.maxColumns));
+
+    // Pass 2: bucket points into column files, recording the smallest x each column actually holds
+    std::vector<std::string> columnFiles;
+    std::vector<double> columnMinX(numColumns, INFINITY);
+    {
+        TRACE_SCOPE("sort_into_columns");
+        std::vector<std::unique_ptr<BufferedWriter>> writers;
+        for (size_t c = 0; c < numColumns; ++c) {
+            columnFiles.push_back(outputPrefix + ".column" + std::to_string(c) + ".tmp");
+            writers.emplace_back(new BufferedWriter(columnFiles.back(), 1 << 20));
+            if (!writers.back()->isOpen()) {
+                std::cerr << "Error: Could not open file " << columnFiles.back() << std::endl;
+                return false;
+            }
+        }
+        for (const auto& p : points) {
+            size_t c = columnOfBin[binOf(p.x)];
+            writers[c]->write(&p, sizeof(Point));
+            columnMinX[c] = std::min(columnMinX[c], p.x);
+        }
+        for (auto& w : writers) {
+            if (!w->close()) {
+                std::cerr << "Error: Failed writing column files" << std::endl;
+                return false;
+            }
+        }
+    }
+
+    // The sweep line after column c is the smallest x of any later point
+    std::vector<double> sweepLine(numColumns, INFINITY);
+    for (size_t c = numColumns - 1; c > 0; --c) sweepLine[c - 1] = std::min(sweepLine[c], columnMinX[c]);
+
+    BufferedWriter vertexOut(outputPrefix + ".vertices");
+    BufferedWriter triangleOut(outputPrefix + ".triangles");
+    if (!vertexOut.isOpen() || !triangleOut.isOpen()) {
+        std::cerr << "Error: Could not open output files " << outputPrefix << ".*" << std::endl;
+        return false;
+    }
+
+    // Same super triangle as the in-core triangulation; its vertices get ids -1, -2, -3
+    double deltaMax = std::max(maxX - minX, maxY - minY);
+    double midX = (minX + maxX) / 2.0;
+    double midY = (minY + maxY) / 2.0;
+    std::vector<ActiveTriangle> active(1);
+    active[0].ids[0] = -1;
+    active[0].ids[1] = -2;
+    active[0].ids[2] = -3;
+    active[0].t = {{midX - 20 * deltaMax, midY - deltaMax}, {midX + 20 * deltaMax, midY - deltaMax},
+                   {midX, midY + 20 * deltaMax}};
+    circumcircle(active[0].t, active[0].cx, active[0].cy, active[0].r2);
+
+    struct StreamEdge {
+        int64_t i1, i2;
+        Point p1, p2;
+    };
+    int64_t nextId = 0;
+    size_t written = 0, peakActive = 1;
+    std::vector<Point> column;
+    std::vector<char> bad;
+    std::vector<StreamEdge> polygon;
+    for (size_t c = 0; c < numColumns; ++c) {
+        TraceScope columnScope("insert_column");
+        {
+            MappedFile file;
+            if (!file.open(columnFiles[c])) {
+                std::cerr << "Error: Could not open file " << columnFiles[c] << std::endl;
+                return false;
+            }
+            column.assign(reinterpret_cast<const Point*>(file.data()),
+                          reinterpret_cast<const Point*>(file.data() + file.size()));
+        }
+        std::remove(columnFiles[c].c_str());
+
+        for (const auto& point : column) {
+            const int64_t id = nextId++;
+            vertexOut.write(&point, sizeof(Point));
+
+            // Find triangles whose circumcircle contains the point
+            bad.assign(active.size(), 0);
+            polygon.clear();
+            for (size_t i = 0; i < active.size(); ++i) {
+                const ActiveTriangle& at = active[i];
+                if (inCircumcircle(point, at.t)) {
+                    bad[i] = 1;
+                    polygon.push_back({at.ids[0], at.ids[1], at.t.a, at.t.b});
+                    polygon.push_back({at.ids[1], at.ids[2], at.t.b, at.t.c});
+                    polygon.push_back({at.ids[2], at.ids[0], at.t.c, at.t.a});
+                }
+            }
+
+            // Remove bad triangles
+            size_t keep = 0;
+            for (size_t i = 0; i < active.size(); ++i) {
+                if (!bad[i]) active[keep++] = active[i];
+            }
+            active.resize(keep);
+
+            // Re-triangulate the cavity from its unique boundary edges
+            for (size_t i = 0; i < polygon.size(); ++i) {
+                bool isUnique = true;
+                for (size_t j = 0; j < polygon.size(); ++j) {
+                    if (i != j && ((polygon[i].i1 == polygon[j].i1 && polygon[i].i2 == polygon[j].i2) ||
+                                   (polygon[i].i1 == polygon[j].i2 && polygon[i].i2 == polygon[j].i1))) {
+                        isUnique = false;
+                        break;
+                    }
+                }
+                if (isUnique) {
+                    ActiveTriangle at;
+                    at.ids[0] = polygon[i].i1;
+                    at.ids[1] = polygon[i].i2;
+                    at.ids[2] = id;
+                    at.t = {polygon[i].p1, polygon[i].p2, point};
+                    circumcircle(at.t, at.cx, at.cy, at.r2);
+                    active.push_back(at);
+                }
+            }
+            peakActive = std::max(peakActive, active.size());
+        }
+
+        // Triangles on the super triangle stay active to the end, so the last column sees the whole boundary and
+        // fills the hull pockets as the in-core triangulation does; flips stop at finalized triangles, whose
+        // circumcircles are empty
+        if (c + 1 == numColumns) {
+            std::map<int64_t, Point> position;
+            std::vector<BasicIndexedEdge<int64_t>> boundary;
+            std::vector<BasicIndexedTriangle<int64_t>> real;
+            for (const auto& at : active) {
+                for (int k = 0; k < 3; ++k) position[at.ids[k]] = (&at.t.a)[k];
+                const int supers = (at.ids[0] < 0) + (at.ids[1] < 0) + (at.ids[2] < 0);
+                if (supers == 0) real.push_back({at.ids[0], at.ids[1], at.ids[2]});
+                for (int k = 0; supers == 1 && k < 3; ++k) {
+                    if (at.ids[k] < 0) boundary.push_back({at.ids[(k + 2) % 3], at.ids[(k + 1) % 3]});
+                }
+            }
+            fillConvexHull([&](int64_t v) { return position[v]; }, boundary, real);
+            active.resize(real.size());
+            for (size_t i = 0; i < real.size(); ++i) {
+                ActiveTriangle& at = active[i];
+                at.ids[0] = real[i].a;
+                at.ids[1] = real[i].b;
+                at.ids[2] = real[i].c;
+                at.t = {position[real[i].a], position[real[i].b], position[real[i].c]};
+                circumcircle(at.t, at.cx, at.cy, at.r2);
+            }
+        }
+
+        // Finalize: write and drop real triangles whose circumcircle lies strictly left of the sweep line
+        columnScope.begin("finalize_column");
+        const double sweepX = sweepLine[c];
+        size_t keep = 0;
+        for (size_t i = 0; i < active.size(); ++i) {
+            const ActiveTriangle& at = active[i];
+            bool real = at.ids[0] >= 0 && at.ids[1] >= 0 && at.ids[2] >= 0;
+            bool final = std::isinf(sweepX) || (real && at.r2 < INFINITY && at.cx + std::sqrt(at.r2) < sweepX);
+            if (!final) {
+                active[keep++] = at;
+            } else if (real) {
+                triangleOut.write(at.ids, sizeof(at.ids));
+                ++written;
+            }
+        }
+        active.resize(keep);
+    }
+
+    bool ok = vertexOut.close() & triangleOut.close();
+    if (!ok) {
+        std::cerr << "Error: Failed writing " << outputPrefix << ".*" << std::endl;
+        return false;
+    }
+    if (stats) {
+        stats->points = n;
+        stats->triangles = written;
+        stats->columns = numColumns;
+        stats->peakActiveTriangles = peakActive;
+    }
+    return true;
+}
+
+// Uniform bucket grid over axis-aligned boxes (points are zero-size boxes), stored as compressed cell lists
+struct BucketGrid {
+    double minX, minY, cellWidth, cellHeight;
+    int nx, ny;
+    std::vector<size_t> start;
+    std::vector<int> items;
+
+    // box(i, x0, y0, x1, y1) reports the bounds of item i
+    template <typename BoxFn>
+    void build(double x0, double y0, double x1, double y1, size_t count, size_t cells, BoxFn box) {
+        double w = std::max(x1 - x0, 1e-300), h = std::max(y1 - y0, 1e-300);
+        double side = std::sqrt(w * h / std::max<size_t>(cells, 1));
+        nx = static_cast<int>(std::min(4096.0, std::max(1.0, std::ceil(w / side))));
+        ny = static_cast<int>(std::min(4096.0, std::max(1.0, std::ceil(h / side))));
+        minX = x0;
+        minY = y0;
+        cellWidth = w / nx;
+        cellHeight = h / ny;
+
+        start.assign(static_cast<size_t>(nx) * ny + 1, 0);
+        for (int pass = 0; pass < 2; ++pass) {
+            std::vector<size_t> cursor(start.begin(), start.end() - 1);
+            for (size_t i = 0; i < count; ++i) {
+                double bx0, by0, bx1, by1;
+                box(i, bx0, by0, bx1, by1);
+                for (int cy = cellY(by0); cy <= cellY(by1); ++cy) {
+                    for (int cx = cellX(bx0); cx <= cellX(bx1); ++cx) {
+                        size_t cell = static_cast<size_t>(cy) * nx + cx;
+                        if (pass == 0) {
+                            ++start[cell + 1];
+                        } else {
+                            items[cursor[cell]++] = static_cast<int>(i);
+                        }
+                    }
+                }
+            }
+            if (pass == 0) {
+                for (size_t c = 1; c < start.size(); ++c) start[c] += start[c - 1];
+                items.resize(start.back());
+            }
+        }
+    }
+
+    int cellX(double x) const {
+        return static_cast<int>(std::min<double>(nx - 1, std::max(0.0, std::floor((x - minX) / cellWidth))));
+    }
+    int cellY(double y) const {
+        return static_cast<int>(std::min<double>(ny - 1, std::max(0.0, std::floor((y - minY) / cellHeight))));
+    }
+
+    // Call fn(item) for the items of every cell overlapping the box; items spanning several cells repeat
+    template <typename Fn>
+    void query(double x0, double y0, double x1, double y1, Fn fn) const {
+        for (int cy = cellY(y0); cy <= cellY(y1); ++cy) {
+            for (int cx = cellX(x0); cx <= cellX(x1); ++cx) {
+                size_t cell = static_cast<size_t>(cy) * nx + cx;
+                for (size_t k = start[cell]; k < start[cell + 1]; ++k) fn(items[k]);
+            }
+        }
+    }
+};
+
+// Regular partition of a bounding box into tiles; outer tiles extend to infinity
+struct TileGrid {
+    double minX, minY, tileWidth, tileHeight;
+    int tilesX, tilesY;
+
+    TileGrid(PointSpan points, int nx, int ny) : tilesX(std::max(1, nx)), tilesY(std::max(1, ny)) {
+        double maxX = points[0].x, maxY = points[0].y;
+        minX = maxX;
+        minY = maxY;
+        for (const auto& p : points) {
+            minX = std::min(minX, p.x);
+            minY = std::min(minY, p.y);
+            maxX = std::max(maxX, p.x);
+            maxY = std::max(maxY, p.y);
+        }
+        tileWidth = std::max(maxX - minX, 1e-300) / tilesX;
+        tileHeight = std::max(maxY - minY, 1e-300) / tilesY;
+    }
+
+    int tileCount() const { return tilesX * tilesY; }
+
+    int tileOf(const Point& p) const {
+        int tx = std::min(tilesX - 1, std::max(0, static_cast<int>((p.x - minX) / tileWidth)));
+        int ty = std::min(tilesY - 1, std::max(0, static_cast<int>((p.y - minY) / tileHeight)));
+        return ty * tilesX + tx;
+    }
+
+    // Half-open region owned by a tile; no point of another tile lies strictly inside it
+    void bounds(int tile, double& x0, double& y0, double& x1, double& y1) const {
+        int tx = tile % tilesX, ty = tile / tilesX;
+        x0 = tx == 0 ? -INFINITY : minX + tx * tileWidth;
+        y0 = ty == 0 ? -INFINITY : minY + ty * tileHeight;
+        x1 = tx == tilesX - 1 ? INFINITY : minX + (tx + 1) * tileWidth;
+        y1 = ty == tilesY - 1 ? INFINITY : minY + (ty + 1) * tileHeight;
+    }
+};
+
+// Statistics of a tiled triangulation and its seam merge
+struct TilingStats {
+    size_t safeTriangles;
+    size_t bandPoints;
+    size_t seamTriangles;
+    bool verified;
+};
+
+// Twice the signed area of triangle abc
+static double orient2d(const Point& a, const Point& b, const Point& c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// Merge independently triangulated tiles into one Delaunay mesh. tileTriangles[t] holds the triangles of the
+// points of tile t (indices into points). A tile triangle whose circumcircle stays inside its tile's region has
+// no other tile's point inside it and is kept. Co-circular points admit several triangulations, so triangles that
+// share a circle are kept or dropped together. The seam band (vertices of all dropped triangles plus every tile's
+// boundary vertices) is re-triangulated, and band triangles whose circumcircle holds no input point complete the
+// mesh, except those inside a kept co-circular cluster, which could pick other diagonals there. The merge is
+// verified: triangles are counter-clockwise, each directed edge is used once, the mesh boundary is a single loop
+// and the counts satisfy Euler's formula for a disk, so seams have neither overlaps nor holes.
+std::vector<IndexedTriangle> stitchTiles(PointSpan points, const TileGrid& grid,
+                                         const std::vector<std::vector<IndexedTriangle>>& tileTriangles,
+                                         TilingStats* stats = nullptr) {
+    TRACE_SCOPE("merge_seams");
+    std::vector<IndexedTriangle> result;
+    std::vector<char> referenced(points.size(), 0);
+    std::vector<char> inBand(points.size(), 0);
+    typedef std::pair<int, int> Incidence;
+    std::vector<Incidence> keptClusters;  // (cluster, vertex) of every kept co-circular cluster
+    int clusterBase = 0;
+
+    for (int tile = 0; tile < grid.tileCount(); ++tile) {
+        double x0, y0, x1, y1;
+        grid.bounds(tile, x0, y0, x1, y1);
+
+        // Directed edges with the tile triangle that owns them; the triangle across an edge owns the reverse edge
+        const std::vector<IndexedTriangle>& triangles = tileTriangles[tile];
+        const int count = static_cast<int>(triangles.size());
+        typedef std::pair<std::pair<int, int>, int> OwnedEdge;
+        std::vector<OwnedEdge> edges;
+        edges.reserve(3 * triangles.size());
+        for (int i = 0; i < count; ++i) {
+            const IndexedTriangle& tri = triangles[i];
+            edges.push_back(OwnedEdge(std::make_pair(tri.a, tri.b), i));
+            edges.push_back(OwnedEdge(std::make_pair(tri.b, tri.c), i));
+            edges.push_back(OwnedEdge(std::make_pair(tri.c, tri.a), i));
+        }
+        std::sort(edges.begin(), edges.end());
+        auto across = [&](int from, int to) {
+            auto it = std::lower_bound(edges.begin(), edges.end(), OwnedEdge(std::make_pair(to, from), INT_MIN));
+            return it != edges.end() && it->first == std::make_pair(to, from) ? it->second : -1;
+        };
+
+        // Vertices on the tile's own boundary join the band: the tile may lack hull triangles there
+        for (const auto& e : edges) {
+            if (across(e.first.first, e.first.second) < 0) inBand[e.first.first] = inBand[e.first.second] = 1;
+        }
+
+        // Triangles whose neighbour's vertex is not clearly outside their circumcircle share it with that
+        // neighbour; such co-circular clusters are kept or sent to the band whole. A cluster leaves for the band
+        // when any of its circumcircles reaches past the tile region.
+        std::vector<int> cluster(count);
+        for (int i = 0; i < count; ++i) cluster[i] = i;
+        auto find = [&](int i) {
+            while (cluster[i] != i) i = cluster[i] = cluster[cluster[i]];
+            return i;
+        };
+        std::vector<char> outside(count);
+        for (int i = 0; i < count; ++i) {
+            const IndexedTriangle& tri = triangles[i];
+            Triangle t = {points[tri.a], points[tri.b], points[tri.c]};
+            double cx, cy, r2;
+            circumcircle(t, cx, cy, r2);
+            double r = std::sqrt(r2);
+            referenced[tri.a] = referenced[tri.b] = referenced[tri.c] = 1;
+            outside[i] = !(cx - r > x0 && cx + r < x1 && cy - r > y0 && cy + r < y1);
+            const int corners[3] = {tri.a, tri.b, tri.c};
+            for (int k = 0; k < 3; ++k) {
+                const int from = corners[k], to = corners[(k + 1) % 3];
+                const int j = across(from, to);
+                if (j < 0) continue;
+                const IndexedTriangle& n = triangles[j];
+                const int o = n.a != from && n.a != to ? n.a : (n.b != from && n.b != to ? n.b : n.c);
+                // Reversing the triangle flips the determinant, so this asks "clearly outside" with the same tolerance
+                if (!inCircumcircle(points[o], Triangle{t.a, t.c, t.b})) cluster[find(i)] = find(j);
+            }
+        }
+        std::vector<char> demoted(count, 0);
+        for (int i = 0; i < count; ++i) {
+            if (outside[i]) demoted[find(i)] = 1;
+        }
+        for (int i = 0; i < count; ++i) {
+            const IndexedTriangle& tri = triangles[i];
+            const int c = find(i);
+            if (demoted[c]) {
+                inBand[tri.a] = inBand[tri.b] = inBand[tri.c] = 1;
+            } else {
+                result.push_back(tri);
+                keptClusters.push_back(Incidence(clusterBase + c, tri.a));
+                keptClusters.push_back(Incidence(clusterBase + c, tri.b));
+                keptClusters.push_back(Incidence(clusterBase + c, tri.c));
+            }
+        }
+        clusterBase += count;
+    }
+    const size_t safeCount = result.size();
+
+    std::vector<int> band;
+    std::vector<Point> bandPoints;
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (inBand[i] || !referenced[i]) {
+            band.push_back(static_cast<int>(i));
+            bandPoints.push_back(points[i]);
+        }
+    }
+
+    // Accept band triangles that are Delaunay with respect to all points
+    BucketGrid pointGrid;
+    pointGrid.build(grid.minX, grid.minY, grid.minX + grid.tileWidth * grid.tilesX,
+                    grid.minY + grid.tileHeight * grid.tilesY, points.size(), points.size() / 4 + 1,
+                    [&](size_t i, double& bx0, double& by0, double& bx1, double& by1) {
+                        bx0 = bx1 = points[i].x;
+                        by0 = by1 = points[i].y;
+                    });
+    auto emptyCircumcircle = [&](const IndexedTriangle& tri) {
+        Triangle t = {points[tri.a], points[tri.b], points[tri.c]};
+        double cx, cy, r2;
+        circumcircle(t, cx, cy, r2);
+        if (!(r2 < INFINITY)) return false;
+        double r = std::sqrt(r2);
+        bool empty = true;
+        pointGrid.query(cx - r, cy - r, cx + r, cy + r, [&](int p) {
+            if (empty && p != tri.a && p != tri.b && p != tri.c && inCircumcircle(points[p], t)) empty = false;
+        });
+        return empty;
+    };
+    size_t seamCount = 0;
+    if (bandPoints.size() >= 3) {
+        std::vector<IndexedTriangle> bandTriangles = delaunayTriangulationIndexed(bandPoints);
+        std::vector<char> accept(bandTriangles.size());
+        parallelFor(bandTriangles.size(), 0, [&](size_t i) {
+            const IndexedTriangle& t = bandTriangles[i];
+            accept[i] = emptyCircumcircle({band[t.a], band[t.b], band[t.c]});
+        });
+        // An accepted band triangle can only overlap a kept one on the same circle, so with all three vertices in
+        // one kept cluster; the cluster already covers it (a kept triangle reappearing is the simplest case)
+        keptClusters.erase(std::remove_if(keptClusters.begin(), keptClusters.end(),
+                                          [&](const Incidence& cv) {
+                                              return !inBand[cv.second] && referenced[cv.second];
+                                          }),
+                           keptClusters.end());
+        std::sort(keptClusters.begin(), keptClusters.end());
+        keptClusters.erase(std::unique(keptClusters.begin(), keptClusters.end()), keptClusters.end());
+        std::vector<Incidence> clustersOf;  // (vertex, cluster)
+        for (const auto& cv : keptClusters) clustersOf.push_back(Incidence(cv.second, cv.first));
+        std::sort(clustersOf.begin(), clustersOf.end());
+        auto insideKeptCluster = [&](const IndexedTriangle& t) {
+            auto it = std::lower_bound(clustersOf.begin(), clustersOf.end(), Incidence(t.a, INT_MIN));
+            for (; it != clustersOf.end() && it->first == t.a; ++it) {
+                if (std::binary_search(keptClusters.begin(), keptClusters.end(), Incidence(it->second, t.b)) &&
+                    std::binary_search(keptClusters.begin(), keptClusters.end(), Incidence(it->second, t.c))) {
+                    return true;
+                }
+            }
+            return false;
+        };
+        for (size_t i = 0; i < bandTriangles.size(); ++i) {
+            IndexedTriangle t = {band[bandTriangles[i].a], band[bandTriangles[i].b], band[bandTriangles[i].c]};
+            if (accept[i] && !insideKeptCluster(t)) {
+                result.push_back(t);
+                ++seamCount;
+            }
+        }
+    }
+
+    // Verify orientation, directed-edge uniqueness and a single boundary loop
+    bool verified = true;
+    std::vector<std::pair<int, int>> edges;
+    edges.reserve(result.size() * 3);
+    for (const auto& tri : result) {
+        if (orient2d(points[tri.a], points[tri.b], points[tri.c]) <= 0) verified = false;
+        edges.push_back(std::make_pair(tri.a, tri.b));
+        edges.push_back(std::make_pair(tri.b, tri.c));
+        edges.push_back(std::make_pair(tri.c, tri.a));
+    }
+    std::sort(edges.begin(), edges.end());
+    std::map<int, int> boundaryNext;
+    for (size_t i = 0; i < edges.size() && verified; ++i) {
+        if (i > 0 && edges[i] == edges[i - 1]) verified = false;
+        if (!std::binary_search(edges.begin(), edges.end(), std::make_pair(edges[i].second, edges[i].first))) {
+            if (!boundaryNext.insert(std::make_pair(edges[i].first, edges[i].second)).second) verified = false;
+        }
+    }
+    if (verified && !boundaryNext.empty()) {
+        const int first = boundaryNext.begin()->first;
+        size_t loopLength = 0;
+        int v = first;
+        do {
+            auto next = boundaryNext.find(v);
+            if (next == boundaryNext.end()) break;
+            v = next->second;
+            ++loopLength;
+        } while (v != first && loopLength <= boundaryNext.size());
+        if (loopLength != boundaryNext.size()) verified = false;
+
+        // A triangulated disk with V vertices and B boundary edges has exactly 2V - B - 2 triangles
+        size_t vertexCount = 0;
+        for (size_t i = 0; i < edges.size(); ++i) {
+            if (i == 0 || edges[i].first != edges[i - 1].first) ++vertexCount;
+        }
+        if (result.size() + boundaryNext.size() + 2 != 2 * vertexCount) verified = false;
+    }
+    if (!verified) {
+        std::cerr << "Error: Tile merge verification failed" << std::endl;
+    }
+
+    if (stats) {
+        stats->safeTriangles = safeCount;
+        stats->bandPoints = band.size();
+        stats->seamTriangles = seamCount;
+        stats->verified = verified;
+    }
+    return result;
+}
+
+// Delaunay triangulation by independent tiles (triangulated in parallel) merged with stitchTiles
+std::vector<IndexedTriangle> tiledDelaunayTriangulation(PointSpan points, int tilesX, int tilesY,
+                                                        unsigned numThreads = 0, TilingStats* stats = nullptr) {
+    TileGrid grid(points, tilesX, tilesY);
+    std::vector<std::vector<int>> members(grid.tileCount());
+    {
+        TRACE_SCOPE("sort_into_tiles");
+        for (size_t i = 0; i < points.size(); ++i) members[grid.tileOf(points[i])].push_back(static_cast<int>(i));
+    }
+
+    std::vector<std::vector<IndexedTriangle>> tileTriangles(grid.tileCount());
+    parallelFor(members.size(), numThreads, [&](size_t tile) {
+        if (members[tile].size() < 3) return;
+        TRACE_SCOPE("tile");
+        std::vector<Point> local;
+        local.reserve(members[tile].size());
+        for (int i : members[tile]) local.push_back(points[i]);
+        for (const auto& t : delaunayTriangulationIndexed(local)) {
+            tileTriangles[tile].push_back({members[tile][t.a], members[tile][t.b], members[tile][t.c]});
+        }
+    });
+    return stitchTiles(points, grid, tileTriangles, stats);
+}
+
+// Compute triangle adjacency by sorting undirected edges
+std::vector<TriangleNeighbors> computeNeighbors(const std::vector<IndexedTriangle>& triangles) {
+    struct EdgeRef {
+        int lo, hi;
+        int triangle, edge;
+        bool operator<(const EdgeRef& o) const { return lo != o.lo ? lo < o.lo : hi < o.hi; }
+    };
+    std::vector<EdgeRef> edges;
+    edges.reserve(triangles.size() * 3);
+    AccountedBytes edgeBytes(memoryAdjacency, capacityBytes(edges));
+    for (size_t t = 0; t < triangles.size(); ++t) {
+        const int v[3] = {triangles[t].a, triangles[t].b, triangles[t].c};
+        for (int k = 0; k < 3; ++k) {
+            int p = v[k], q = v[(k + 1) % 3];
+            edges.push_back({std::min(p, q), std::max(p, q), static_cast<int>(t), k});
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<TriangleNeighbors> neighbors(triangles.size(), TriangleNeighbors{{-1, -1, -1}});
+    AccountedBytes neighborBytes(memoryAdjacency, capacityBytes(neighbors));
+    for (size_t i = 0; i + 1 < edges.size(); ++i) {
+        if (edges[i].lo == edges[i + 1].lo && edges[i].hi == edges[i + 1].hi) {
+            neighbors[edges[i].triangle].n[edges[i].edge] = edges[i + 1].triangle;
+            neighbors[edges[i + 1].triangle].n[edges[i + 1].edge] = edges[i].triangle;
+            ++i;
+        }
+    }
+    return neighbors;
+}
+
+// Binary mesh snapshot layout (version 1, native byte order): a 128-byte header, a table of 64-byte channel
+// records, then the vertex, triangle, neighbor and channel arrays, each starting on a 64-byte boundary.
+// Every array is stored exactly as the in-memory type, so a mapped snapshot is usable without parsing.
+struct SnapshotHeader {
+    char magic[8];            // "DLNYMESH"
+    uint32_t version;
+    uint32_t byteOrder;       // 0x01020304 as written by the producing machine
+    uint64_t vertexCount;
+    uint64_t triangleCount;
+    uint64_t channelCount;
+    uint64_t vertexOffset;
+    uint64_t triangleOffset;
+    uint64_t neighborOffset;
+    uint64_t channelTableOffset;
+    uint64_t fileSize;
+    char reserved[48];
+};
+
+struct SnapshotChannel {
+    char name[48];
+    uint32_t components;
+    uint32_t reserved;
+    uint64_t offset;
+};
+
+static_assert(sizeof(SnapshotHeader) == 128, "snapshot header layout");
+static_assert(sizeof(SnapshotChannel) == 64, "snapshot channel layout");
+static_assert(sizeof(TriangleNeighbors) == 3 * sizeof(int32_t), "TriangleNeighbors must be packed");
+
+const uint32_t snapshotVersion = 1;
+const uint64_t snapshotAlignment = 64;
+
+static uint64_t alignSnapshotOffset(uint64_t offset) {
+    return (offset + snapshotAlignment - 1) / snapshotAlignment * snapshotAlignment;
+}
+
+// Write a mesh snapshot; neighbors are computed when not supplied
+bool writeMeshSnapshot(const std::string& filename, PointSpan vertices, const std::vector<IndexedTriangle>& triangles,
+                       const PointAttributes& attributes,
+                       const std::vector<TriangleNeighbors>* neighbors = nullptr) {
+    std::vector<TriangleNeighbors> computed;
+    if (!neighbors) {
+        computed = computeNeighbors(triangles);
+        neighbors = &computed;
+    }
+
+    SnapshotHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "DLNYMESH", 8);
+    header.version = snapshotVersion;
+    header.byteOrder = 0x01020304;
+    header.vertexCount = vertices.size();
+    header.triangleCount = triangles.size();
+    header.channelCount = attributes.channels.size();
+    header.channelTableOffset = sizeof(SnapshotHeader);
+    header.vertexOffset = alignSnapshotOffset(header.channelTableOffset + header.channelCount * sizeof(SnapshotChannel));
+    header.triangleOffset = alignSnapshotOffset(header.vertexOffset + vertices.size() * sizeof(Point));
+    header.neighborOffset = alignSnapshotOffset(header.triangleOffset + triangles.size() * sizeof(IndexedTriangle));
+    uint64_t end = header.neighborOffset + triangles.size() * sizeof(TriangleNeighbors);
+
+    std::vector<SnapshotChannel> table(attributes.channels.size());
+    for (size_t i = 0; i < table.size(); ++i) {
+        const AttributeChannel& ch = attributes.channels[i];
+        std::memset(&table[i], 0, sizeof(SnapshotChannel));
+        std::strncpy(table[i].name, ch.name.c_str(), sizeof(table[i].name) - 1);
+        table[i].components = static_cast<uint32_t>(ch.components);
+        table[i].offset = alignSnapshotOffset(end);
+        end = table[i].offset + ch.values.size() * sizeof(double);
+    }
+    header.fileSize = end;
+
+    BufferedWriter out(filename);
+    if (!out.isOpen()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+    uint64_t position = 0;
+    auto writeAt = [&](uint64_t offset, const void* data, size_t size) {
+        static const char zeros[snapshotAlignment] = {};
+        for (; position < offset; ++position) out.write(zeros, 1);
+        out.write(data, size);
+        position += size;
+    };
+    writeAt(0, &header, sizeof(header));
+    if (!table.empty()) writeAt(header.channelTableOffset, table.data(), table.size() * sizeof(SnapshotChannel));
+    writeAt(header.vertexOffset, vertices.begin(), vertices.size() * sizeof(Point));
+    writeAt(header.triangleOffset, triangles.data(), triangles.size() * sizeof(IndexedTriangle));
+    writeAt(header.neighborOffset, neighbors->data(), neighbors->size() * sizeof(TriangleNeighbors));
+    for (size_t i = 0; i < table.size(); ++i) {
+        const std::vector<double>& values = attributes.channels[i].values;
+        writeAt(table[i].offset, values.data(), values.size() * sizeof(double));
+    }
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Memory-mapped mesh snapshot; all accessors point straight into the mapping
+class MeshSnapshot {
+public:
+    struct Channel {
+        std::string name;
+        int components;
+        const double* values;
+    };
+
+    MeshSnapshot() : header(nullptr) {}
+
+    bool open(const std::string& filename) {
+        if (!file.open(filename)) {
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+            return false;
+        }
+        const char* base = file.data();
+        const size_t size = file.size();
+        header = reinterpret_cast<const SnapshotHeader*>(base);
+        bool valid = size >= sizeof(SnapshotHeader) && std::memcmp(header->magic, "DLNYMESH", 8) == 0;
+        if (valid && (header->version != snapshotVersion || header->byteOrder != 0x01020304)) {
+            std::cerr << "Error: " << filename << " has snapshot version " << header->version
+                      << " or a foreign byte order" << std::endl;
+            return false;
+        }
+        // count elements of elementSize bytes at offset; divides rather than multiplies, so huge counts cannot wrap
+        auto fits = [&](uint64_t offset, uint64_t count, uint64_t elementSize) {
+            return offset % alignof(double) == 0 && offset <= size && count <= (size - offset) / elementSize;
+        };
+        valid = valid && header->fileSize == size &&
+                fits(header->channelTableOffset, header->channelCount, sizeof(SnapshotChannel)) &&
+                fits(header->vertexOffset, header->vertexCount, sizeof(Point)) &&
+                fits(header->triangleOffset, header->triangleCount, sizeof(IndexedTriangle)) &&
+                fits(header->neighborOffset, header->triangleCount, sizeof(TriangleNeighbors));
+        channels.clear();
+        for (uint64_t i = 0; valid && i < header->channelCount; ++i) {
+            const SnapshotChannel& ch = reinterpret_cast<const SnapshotChannel*>(base + header->channelTableOffset)[i];
+            valid = ch.components >= 1 && ch.components <= 3 &&
+                    fits(ch.offset, header->vertexCount, ch.components * sizeof(double));
+            if (valid) {
+                channels.push_back({std::string(ch.name, std::find(ch.name, ch.name + sizeof(ch.name), '\0')),
+                                    static_cast<int>(ch.components),
+                                    reinterpret_cast<const double*>(base + ch.offset)});
+            }
+        }
+        if (!valid) {
+            std::cerr << "Error: " << filename << " is not a valid mesh snapshot" << std::endl;
+            file.close();
+            return false;
+        }
+        return true;
+    }
+
+    PointSpan vertices() const {
+        return PointSpan(reinterpret_cast<const Point*>(file.data() + header->vertexOffset), header->vertexCount);
+    }
+    const IndexedTriangle* triangles() const {
+        return reinterpret_cast<const IndexedTriangle*>(file.data() + header->triangleOffset);
+    }
+    const TriangleNeighbors* neighbors() const {
+        return reinterpret_cast<const TriangleNeighbors*>(file.data() + header->neighborOffset);
+    }
+    size_t triangleCount() const { return header->triangleCount; }
+
+    std::vector<Channel> channels;
+
+private:
+    MappedFile file;
+    const SnapshotHeader* header;
+};
+
+// 128-bit content hash: two independent multiply-rotate lanes over 64-bit words, 1 MiB chunks hashed in parallel
+struct ContentHash {
+    uint64_t h1, h2;
+
+    std::string hex() const {
+        char buf[33];
+        std::snprintf(buf, sizeof(buf), "%016llx%016llx", static_cast<unsigned long long>(h1),
+                      static_cast<unsigned long long>(h2));
+        return buf;
+    }
+};
+
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdull;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ull;
+    return x ^ (x >> 33);
+}
+
+static uint64_t rotl64(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+static ContentHash hashChunk(const unsigned char* data, size_t size, uint64_t seed) {
+    uint64_t h1 = seed ^ (size * 0x9E3779B97F4A7C15ull), h2 = ~seed ^ size;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, data + i, 8);
+        h1 = rotl64(h1 ^ (w * 0x87c37b91114253d5ull), 31) * 0x4cf5ad432745937full;
+        h2 = rotl64(h2 ^ (w * 0x52dce729da3ed8b5ull), 27) * 0x38495ab5a2f3c1e7ull;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, data + i, size - i);
+    h1 = mix64(h1 ^ tail);
+    h2 = mix64(h2 ^ rotl64(tail, 32) ^ h1);
+    return {h1, h2};
+}
+
+ContentHash contentHash(const void* data, size_t size, unsigned numThreads = 0) {
+    const size_t chunk = 1 << 20;
+    const size_t numChunks = std::max<size_t>(1, (size + chunk - 1) / chunk);
+    std::vector<ContentHash> parts(numChunks);
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    parallelFor(numChunks, numThreads, [&](size_t k) {
+        size_t first = k * chunk;
+        parts[k] = hashChunk(bytes + first, std::min(chunk, size - std::min(size, first)), k);
+    });
+    return hashChunk(reinterpret_cast<const unsigned char*>(parts.data()), parts.size() * sizeof(ContentHash), size);
+}
+
+// Options for the on-disk triangulation cache
+struct CacheOptions {
+    std::string directory;
+    uint64_t maxBytes;     // total size of cached snapshots
+    size_t maxEntries;
+
+    CacheOptions() : directory(".delaunay-cache"), maxBytes(uint64_t(4) << 30), maxEntries(1024) {}
+};
+
+// Content-addressed cache of mesh snapshots. Entries are named by the hash of the input points and the
+// triangulation options; a file's modification time records its last use, and the least recently used
+// entries are evicted once the size or entry limit is exceeded. Available on POSIX systems only.
+class TriangulationCache {
+public:
+    explicit TriangulationCache(const CacheOptions& cacheOptions = CacheOptions()) : options(cacheOptions) {
+#if defined(__unix__) || defined(__APPLE__)
+        ::mkdir(options.directory.c_str(), 0755);
+#endif
+    }
+
+    static std::string key(PointSpan points, const std::string& triangulationOptions) {
+        ContentHash h = contentHash(points.begin(), points.size() * sizeof(Point));
+        ContentHash o = contentHash(triangulationOptions.data(), triangulationOptions.size());
+        return ContentHash{h.h1 ^ mix64(o.h1), h.h2 ^ mix64(o.h2 + 1)}.hex();
+    }
+
+    // Map the snapshot stored under key; marks the entry as recently used
+    bool lookup(const std::string& key, MeshSnapshot& snapshot) const {
+#if defined(__unix__) || defined(__APPLE__)
+        std::string path = pathOf(key);
+        if (::access(path.c_str(), R_OK) != 0 || !snapshot.open(path)) return false;
+        ::utimensat(AT_FDCWD, path.c_str(), nullptr, 0);
+        return true;
+#else
+        (void)key;
+        (void)snapshot;
+        return false;
+#endif
+    }
+
+    // Store a triangulation under key (written to a temporary file and renamed into place), then evict
+    bool store(const std::string& key, PointSpan points, const std::vector<IndexedTriangle>& triangles) {
+#if defined(__unix__) || defined(__APPLE__)
+        std::string path = pathOf(key);
+        std::string temporary = path + ".tmp" + std::to_string(::getpid());
+        if (!writeMeshSnapshot(temporary, points, triangles, PointAttributes()) ||
+            std::rename(temporary.c_str(), path.c_str()) != 0) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+        evict();
+        return true;
+#else
+        (void)key;
+        (void)points;
+        (void)triangles;
+        return false;
+#endif
+    }
+
+    // Remove least recently used entries until the cache is within its limits
+    void evict() const {
+#if defined(__unix__) || defined(__APPLE__)
+        struct Entry {
+            std::string path;
+            uint64_t bytes;
+            struct timespec used;
+        };
+        std::vector<Entry> entries;
+        uint64_t total = 0;
+        if (DIR* dir = ::opendir(options.directory.c_str())) {
+            while (dirent* item = ::readdir(dir)) {
+                std::string name = item->d_name;
+                if (name.size() < 5 || name.compare(name.size() - 5, 5, ".mesh") != 0) continue;
+                std::string path = options.directory + "/" + name;
+                struct stat info;
+                if (::stat(path.c_str(), &info) != 0) continue;
+#if defined(__APPLE__)
+                entries.push_back({path, static_cast<uint64_t>(info.st_size), info.st_mtimespec});
+#else
+                entries.push_back({path, static_cast<uint64_t>(info.st_size), info.st_mtim});
+#endif
+                total += info.st_size;
+            }
+            ::closedir(dir);
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return a.used.tv_sec != b.used.tv_sec ? a.used.tv_sec < b.used.tv_sec : a.used.tv_nsec < b.used.tv_nsec;
+        });
+        size_t remaining = entries.size();
+        for (const auto& e : entries) {
+            if (total <= options.maxBytes && remaining <= options.maxEntries) break;
+            if (std::remove(e.path.c_str()) == 0) {
+                total -= e.bytes;
+                --remaining;
+            }
+        }
+#endif
+    }
+
+private:
+    std::string pathOf(const std::string& key) const { return options.directory + "/" + key + ".mesh"; }
+
+    CacheOptions options;
+};
+
+// Version of the core's output in cache keys. Bump it whenever the predicates, or anything else that changes the
+// mesh for the same input, change, so stale entries miss (2: relative incircle tolerance, 3: hull pockets filled)
+const char* const triangulationCacheVersion = "bowyer-watson/3";
+
+// Delaunay triangulation through the cache: a repeated input costs a hash and an mmap.
+// A hit is trusted only if the snapshot holds as many vertices as the input; a failed store
+// (or an entry evicted straight away by a tight limit) still returns the computed mesh.
+std::vector<IndexedTriangle> cachedDelaunayTriangulation(PointSpan points, TriangulationCache& cache,
+                                                         bool* hit = nullptr) {
+    const std::string key = TriangulationCache::key(points, triangulationCacheVersion);
+    MeshSnapshot mesh;
+    if (cache.lookup(key, mesh) && mesh.vertices().size() == points.size()) {
+        if (hit) *hit = true;
+        return std::vector<IndexedTriangle>(mesh.triangles(), mesh.triangles() + mesh.triangleCount());
+    }
+    if (hit) *hit = false;
+    std::vector<IndexedTriangle> triangles = delaunayTriangulationIndexed(points);
+    if (!cache.store(key, points, triangles)) {
+        std::cerr << "Warning: Could not store triangulation in cache" << std::endl;
+    }
+    return triangles;
+}
+
+#if defined(__linux__)
+// CPU sets of the online NUMA nodes, read from sysfs (one entry with no CPUs when unavailable)
+static std::vector<std::vector<int>> numaNodeCpus() {
+    std::vector<std::vector<int>> nodes;
+    for (int node = 0;; ++node) {
+        std::ifstream in("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!in.is_open()) break;
+        std::vector<int> cpus;
+        std::string range;
+        while (std::getline(in, range, ',')) {
+            int first = 0, last = 0;
+            if (std::sscanf(range.c_str(), "%d-%d", &first, &last) == 2) {
+                for (int c = first; c <= last; ++c) cpus.push_back(c);
+            } else if (std::sscanf(range.c_str(), "%d", &first) == 1) {
+                cpus.push_back(first);
+            }
+        }
+        if (!cpus.empty()) nodes.push_back(cpus);
+    }
+    if (nodes.empty()) nodes.push_back(std::vector<int>());
+    return nodes;
+}
+
+// Shared memory segment (memfd, or an unlinked POSIX shm object) mapped before fork so workers can fill it
+class SharedSegment {
+public:
+    SharedSegment() : base(nullptr), length(0) {}
+    ~SharedSegment() {
+        if (base) ::munmap(base, length);
+    }
+    SharedSegment(const SharedSegment&) = delete;
+    SharedSegment& operator=(const SharedSegment&) = delete;
+
+    bool create(size_t size) {
+#if defined(MFD_CLOEXEC)
+        int fd = ::memfd_create("delaunay-shard", MFD_CLOEXEC);
+#else
+        std::string name = "/delaunay-shard-" + std::to_string(::getpid()) + "-" + std::to_string(counter()++);
+        int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd >= 0) ::shm_unlink(name.c_str());
+#endif
+        if (fd < 0) return false;
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            ::close(fd);
+            return false;
+        }
+        void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (address == MAP_FAILED) return false;
+        base = address;
+        length = size;
+        return true;
+    }
+
+    void* data() const { return base; }
+
+private:
+#if !defined(MFD_CLOEXEC)
+    static int& counter() {
+        static int value = 0;
+        return value;
+    }
+#endif
+    void* base;
+    size_t length;
+};
+#endif
+
+// Options for multi-process sharded triangulation
+struct ShardingOptions {
+    int workers;      // worker processes, rounded up to a full shard grid (0 = one per hardware thread)
+    bool pinToNuma;   // pin worker w to the CPUs of NUMA node w % nodes
+
+    ShardingOptions() : workers(0), pinToNuma(true) {}
+};
+
+// Delaunay triangulation by forked worker processes. Each worker is pinned to a NUMA node, triangulates one
+// spatial shard with memory it allocates (first touch keeps it node-local) and writes the triangles into its own
+// shared memory segment; the coordinator then merges the shards with stitchTiles, which also resolves
+// co-circular ties along the shard seams. Without fork (non-Linux) the shards are triangulated on threads instead.
+std::vector<IndexedTriangle> shardedDelaunayTriangulation(PointSpan points,
+                                                          const ShardingOptions& options = ShardingOptions(),
+                                                          TilingStats* stats = nullptr) {
+    int workers = options.workers > 0 ? options.workers
+                                      : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int tilesX = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(workers))));
+    int tilesY = (workers + tilesX - 1) / tilesX;
+#if !defined(__linux__)
+    return tiledDelaunayTriangulation(points, tilesX, tilesY, 0, stats);
+#else
+    TileGrid grid(points, tilesX, tilesY);
+    std::vector<std::vector<int>> members(grid.tileCount());
+    for (size_t i = 0; i < points.size(); ++i) members[grid.tileOf(points[i])].push_back(static_cast<int>(i));
+
+    // Segment layout: triangle count followed by up to 2m triangles (Euler bound for m points)
+    std::vector<std::unique_ptr<SharedSegment>> segments;
+    for (const auto& shard : members) {
+        segments.emplace_back(new SharedSegment());
+        size_t capacity = 2 * shard.size() + 1;
+        if (!segments.back()->create(sizeof(uint64_t) + capacity * sizeof(IndexedTriangle))) {
+            std::cerr << "Error: Could not create shared memory segment" << std::endl;
+            return std::vector<IndexedTriangle>();
+        }
+        *static_cast<uint64_t*>(segments.back()->data()) = 0;
+    }
+
+    std::vector<std::vector<int>> nodes = numaNodeCpus();
+    std::cout.flush();
+    std::cerr.flush();
+    std::vector<pid_t> children;
+    for (size_t shard = 0; shard < members.size(); ++shard) {
+        pid_t pid = ::fork();
+        if (pid < 0) {
+            std::cerr << "Error: fork failed" << std::endl;
+            break;
+        }
+        if (pid > 0) {
+            children.push_back(pid);
+            continue;
+        }
+
+        // Worker process: pin, triangulate the shard, publish, exit without running parent destructors
+        const std::vector<int>& cpus = nodes[shard % nodes.size()];
+        if (options.pinToNuma && !cpus.empty()) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            for (int c : cpus) CPU_SET(c, &set);
+            ::sched_setaffinity(0, sizeof(set), &set);
+        }
+        const std::vector<int>& shardPoints = members[shard];
+        if (shardPoints.size() >= 3) {
+            std::vector<Point> local;
+            local.reserve(shardPoints.size());
+            for (int i : shardPoints) local.push_back(points[i]);
+            std::vector<IndexedTriangle> triangles = delaunayTriangulationIndexed(local);
+            IndexedTriangle* out = reinterpret_cast<IndexedTriangle*>(
+                static_cast<char*>(segments[shard]->data()) + sizeof(uint64_t));
+            // A dropped triangle would leave a hole the merge cannot repair, so overflow fails the worker
+            if (triangles.size() > 2 * shardPoints.size() + 1) ::_exit(1);
+            size_t count = triangles.size();
+            for (size_t t = 0; t < count; ++t) {
+                out[t] = {shardPoints[triangles[t].a], shardPoints[triangles[t].b], shardPoints[triangles[t].c]};
+            }
+            *static_cast<uint64_t*>(segments[shard]->data()) = count;
+        }
+        ::_exit(0);
+    }
+
+    bool ok = children.size() == members.size();
+    TRACE_SCOPE("wait_for_shards");
+    for (pid_t pid : children) {
+        int status = 0;
+        if (::waitpid(pid, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) ok = false;
+    }
+    if (!ok) {
+        std::cerr << "Error: A shard worker failed" << std::endl;
+        return std::vector<IndexedTriangle>();
+    }
+
+    std::vector<std::vector<IndexedTriangle>> shardTriangles(members.size());
+    for (size_t shard = 0; shard < members.size(); ++shard) {
+        const char* base = static_cast<const char*>(segments[shard]->data());
+        const IndexedTriangle* triangles = reinterpret_cast<const IndexedTriangle*>(base + sizeof(uint64_t));
+        shardTriangles[shard].assign(triangles, triangles + *reinterpret_cast<const uint64_t*>(base));
+    }
+    segments.clear();
+    return stitchTiles(points, grid, shardTriangles, stats);
+#endif
+}
+
+// Packed file of many arrays (version 1, native byte order): 8-byte magic, uint32 version, uint32 reserved,
+// uint64 array count n, uint64 element offsets[n + 1], then all elements back to back
+struct PackHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t count;
+};
+
+static_assert(sizeof(PackHeader) == 24, "pack header layout");
+
+// Write n arrays; array(i, length) returns a pointer to array i and sets its length in elements
+template <typename T, typename ArrayFn>
+bool writePackedArrays(const std::string& filename, const char* magic, size_t n, ArrayFn array) {
+    BufferedWriter out(filename);
+    if (!out.isOpen()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+    PackHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, magic, 8);
+    header.version = 1;
+    header.count = n;
+    out.write(&header, sizeof(header));
+    uint64_t offset = 0;
+    out.write(&offset, sizeof(offset));
+    for (size_t i = 0; i < n; ++i) {
+        size_t length = 0;
+        array(i, length);
+        offset += length;
+        out.write(&offset, sizeof(offset));
+    }
+    for (size_t i = 0; i < n; ++i) {
+        size_t length = 0;
+        const T* data = array(i, length);
+        out.write(data, length * sizeof(T));
+    }
+    if (!out.close()) {
+        std::cerr << "Error: Failed writing " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Memory-mapped packed file; arrays are read in place
+template <typename T>
+class PackedArrays {
+public:
+    PackedArrays() : offsets(nullptr), elements(nullptr), n(0) {}
+
+    bool open(const std::string& filename, const char* magic) {
+        if (!file.open(filename)) {
+            std::cerr << "Error: Could not open file " << filename << std::endl;
+            return false;
+        }
+        const PackHeader* header = reinterpret_cast<const PackHeader*>(file.data());
+        bool valid = file.size() >= sizeof(PackHeader) && std::memcmp(header->magic, magic, 8) == 0 &&
+                     header->version == 1 && header->count < file.size() / sizeof(uint64_t);
+        if (valid) {
+            n = header->count;
+            offsets = reinterpret_cast<const uint64_t*>(file.data() + sizeof(PackHeader));
+            size_t dataOffset = sizeof(PackHeader) + (n + 1) * sizeof(uint64_t);
+            valid = dataOffset <= file.size() && offsets[n] <= (file.size() - dataOffset) / sizeof(T);
+
+            // Offsets must not decrease, or length() would wrap and data() point outside the payload
+            for (size_t i = 0; valid && i < n; ++i) valid = offsets[i] <= offsets[i + 1];
+            elements = reinterpret_cast<const T*>(file.data() + dataOffset);
+        }
+        if (!valid) {
+            std::cerr << "Error: " << filename << " is not a valid packed file" << std::endl;
+            n = 0;
+            return false;
+        }
+        return true;
+    }
+
+    size_t size() const { return n; }
+    const T* data(size_t i) const { return elements + offsets[i]; }
+    size_t length(size_t i) const { return offsets[i + 1] - offsets[i]; }
+
+private:
+    MappedFile file;
+    const uint64_t* offsets;
+    const T* elements;
+    size_t n;
+};
+
+const char* const pointPackMagic = "DLNYPNTS";
+const char* const trianglePackMagic = "DLNYTRIS";
+
+// Write many small point sets into one packed file for runBatch
+bool writePointPack(const std::string& filename, const std::vector<std::vector<Point>>& sets) {
+    return writePackedArrays<Point>(filename, pointPackMagic, sets.size(), [&](size_t i, size_t& length) {
+        length = sets[i].size();
+        return sets[i].data();
+    });
+}
+
+// Statistics of a batch run
+struct BatchStats {
+    size_t jobs;
+    size_t failed;
+    size_t triangles;
+    double seconds;
+};
+
+// Triangulate many small point sets concurrently. The input is a point pack (.pack) or a manifest with one
+// point file per line; the result is one triangle pack with each job's triangles indexing its own points.
+// Worker threads claim jobs in groups and keep per-thread scratch and result arenas, so the steady state
+// allocates nothing per job; the arenas are written out in job order at the end.
+bool runBatch(const std::string& input, const std::string& output, unsigned numThreads = 0,
+              BatchStats* stats = nullptr) {
+    if (stats) *stats = BatchStats();
+    auto start = std::chrono::high_resolution_clock::now();
+    PackedArrays<Point> pack;
+    std::vector<std::string> manifest;
+    const bool packed = input.size() >= 5 && input.compare(input.size() - 5, 5, ".pack") == 0;
+    if (packed) {
+        if (!pack.open(input, pointPackMagic)) return false;
+    } else {
+        std::ifstream list(input);
+        if (!list.is_open()) {
+            std::cerr << "Error: Could not open file " << input << std::endl;
+            return false;
+        }
+        std::string line;
+        while (std::getline(list, line)) {
+            if (!line.empty() && line[0] != '#') manifest.push_back(line);
+        }
+    }
+    const size_t jobCount = packed ? pack.size() : manifest.size();
+
+    struct Arena {
+        TriangulationScratch scratch;
+        std::vector<IndexedTriangle> work;
+        std::vector<IndexedTriangle> triangles;
+    };
+    if (numThreads == 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<Arena> arenas(numThreads);
+    std::vector<uint64_t> jobStart(jobCount), jobLength(jobCount);
+    std::vector<uint32_t> jobArena(jobCount);
+    std::atomic<size_t> next(0), failed(0);
+    const size_t grain = 64;
+
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < numThreads; ++w) {
+        workers.emplace_back([&, w]() {
+            Arena& arena = arenas[w];
+            setTraceThreadName("batch worker");
+            for (size_t first = next.fetch_add(grain); first < jobCount; first = next.fetch_add(grain)) {
+                TRACE_SCOPE("job_group");
+                for (size_t j = first; j < std::min(jobCount, first + grain); ++j) {
+                    PointCloud cloud;
+                    PointSpan points(nullptr, 0);
+                    if (packed) {
+                        points = PointSpan(pack.data(j), pack.length(j));
+                    } else if (loadPointCloud(manifest[j], cloud, 1)) {
+                        points = cloud.points();
+                    } else {
+                        ++failed;
+                    }
+                    arena.work.clear();
+                    if (points.size() >= 3) delaunayTriangulationIndexed(points, arena.work, arena.scratch);
+                    jobArena[j] = w;
+                    jobStart[j] = arena.triangles.size();
+                    jobLength[j] = arena.work.size();
+                    arena.triangles.insert(arena.triangles.end(), arena.work.begin(), arena.work.end());
+                }
+            }
+        });
+    }
+    for (auto& t : workers) t.join();
+
+    bool ok = writePackedArrays<IndexedTriangle>(output, trianglePackMagic, jobCount, [&](size_t j, size_t& length) {
+        length = jobLength[j];
+        return arenas[jobArena[j]].triangles.data() + jobStart[j];
+    });
+
+    if (stats) {
+        stats->jobs = jobCount;
+        stats->failed = failed;
+        stats->triangles = 0;
+        for (const auto& arena : arenas) stats->triangles += arena.triangles.size();
+        stats->seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+    return ok && failed == 0;
+}
+
+// Encoding choices for exportMesh
+struct ExportOptions {
+    bool binary;    // legacy VTK as BINARY instead of ASCII
+    bool compress;  // LZ4-compress .vtu appended data
+
+    ExportOptions() : binary(false), compress(false) {}
+};
+
+// Export a mesh in the format given by the file extension: .mesh snapshot, .vtu XML, otherwise legacy VTK
+// (ASCII formatted in parallel, or BINARY)
+bool exportMesh(PointSpan vertices, const std::vector<IndexedTriangle>& triangles, const PointAttributes& attributes,
+                const std::string& filename, const ExportOptions& options = ExportOptions()) {
+    TRACE_SCOPE("export");
+    auto endsWith = [&](const std::string& suffix) {
+        return filename.size() >= suffix.size() &&
+               filename.compare(filename.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    if (endsWith(".mesh")) {
+        if (!writeMeshSnapshot(filename, vertices, triangles, attributes)) return false;
+        std::cout << "Exported to " << filename << std::endl;
+        return true;
+    }
+    if (endsWith(".vtu")) return exportToVTU(vertices, triangles, attributes, filename, options.compress);
+    if (options.binary) return exportToVTKBinary(vertices, triangles, attributes, filename);
+    return exportToVTKParallel(vertices, triangles, attributes, filename);
+}
+
+// Blocking queue with a fixed capacity; pop returns false once the queue is closed and drained
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity(std::max<size_t>(1, capacity)), closed(false) {}
+
+    void push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [&] { return items.size() < capacity; });
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+    }
+
+    // Push unless the queue stays full for the whole timeout
+    bool tryPush(T& item, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!notFull.wait_for(lock, timeout, [&] { return items.size() < capacity; })) return false;
+        items.push_back(std::move(item));
+        notEmpty.notify_one();
+        return true;
+    }
+
+    // Pop up to maxItems at once; waits like pop for the first one
+    bool popBatch(std::vector<T>& out, size_t maxItems) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&] { return !items.empty() || closed; });
+        if (items.empty()) return false;
+        out.clear();
+        while (!items.empty() && out.size() < maxItems) {
+            out.push_back(std::move(items.front()));
+            items.pop_front();
+        }
+        notFull.notify_all();
+        return true;
+    }
+
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [&] { return !items.empty() || closed; });
+        if (items.empty()) return false;
+        item = std::move(items.front());
+        items.pop_front();
+        notFull.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+    }
+
+private:
+    size_t capacity;
+    bool closed;
+    std::deque<T> items;
+    std::mutex mutex;
+    std::condition_variable notFull, notEmpty;
+};
+
+// Options for the batch pipeline
+struct PipelineOptions {
+    std::string outputDirectory;
+    std::string outputExtension;  // selects the format, see exportMesh
+    ExportOptions exportOptions;
+    unsigned readers;
+    unsigned triangulators;       // 0 = one per hardware thread
+    unsigned writers;
+    size_t queueDepth;            // jobs buffered between stages
+
+    PipelineOptions() : outputDirectory("."), outputExtension(".vtk"), readers(1), triangulators(0), writers(1),
+                        queueDepth(4) {}
+};
+
+// Statistics of a pipeline run
+struct PipelineStats {
+    size_t files;
+    size_t failed;
+    size_t points;
+    size_t triangles;
+    double seconds;
+};
+
+// Triangulate many files with reading, triangulation and writing running concurrently. Reader and writer
+// threads do the blocking file I/O while triangulator threads compute; bounded queues between the stages
+// cap the number of clouds and meshes held in memory.
+bool runPipeline(const std::vector<std::string>& inputs, const PipelineOptions& options = PipelineOptions(),
+                 PipelineStats* stats = nullptr) {
+    struct Job {
+        std::string input, output;
+        std::unique_ptr<PointCloud> cloud;
+        std::vector<IndexedTriangle> triangles;
+    };
+    auto start = std::chrono::high_resolution_clock::now();
+    BoundedQueue<std::unique_ptr<Job>> loaded(options.queueDepth), triangulated(options.queueDepth);
+    std::atomic<size_t> nextInput(0), failed(0), points(0), triangles(0);
+
+    // Output names keep the input's file name with its extension (pts.xyz -> pts.xyz.vtk), so inputs differing
+    // only in format do not overwrite each other; same-named inputs from different directories still collide, and
+    // every input after the first to claim a name fails instead of silently replacing that output
+    std::vector<std::string> outputs(inputs.size());
+    std::vector<size_t> firstClaim(inputs.size());
+    std::map<std::string, size_t> claimed;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        size_t slash = inputs[i].find_last_of("/\\");
+        outputs[i] = options.outputDirectory + "/" + inputs[i].substr(slash == std::string::npos ? 0 : slash + 1) +
+                     options.outputExtension;
+        firstClaim[i] = claimed.insert(std::make_pair(outputs[i], i)).first->second;
+    }
+    // A stage runs count threads of body and calls done (closing its output queue) after the last one exits
+    auto runStage = [](unsigned count, std::function<void()> body, std::function<void()> done) {
+        return std::thread([count, body, done]() {
+            std::vector<std::thread> threads;
+            for (unsigned i = 0; i < std::max(1u, count); ++i) threads.emplace_back(body);
+            for (auto& t : threads) t.join();
+            done();
+        });
+    };
+
+    std::thread readStage = runStage(options.readers, [&]() {
+        setTraceThreadName("reader");
+        for (size_t i = nextInput++; i < inputs.size(); i = nextInput++) {
+            std::unique_ptr<Job> job(new Job());
+            job->input = inputs[i];
+            job->output = outputs[i];
+            if (firstClaim[i] != i) {
+                std::cerr << "Error: Skipping " << job->input << ": " << job->output << " is already written for "
+                          << inputs[firstClaim[i]] << std::endl;
+                ++failed;
+                continue;
+            }
+            job->cloud.reset(new PointCloud());
+            if (!loadPointCloud(job->input, *job->cloud, 1) || job->cloud->count < 3) {
+                std::cerr << "Error: Skipping " << job->input << std::endl;
+                ++failed;
+                continue;
+            }
+            loaded.push(std::move(job));
+        }
+    }, [&]() { loaded.close(); });
+
+    unsigned triangulators = options.triangulators ? options.triangulators
+                                                   : std::max(1u, std::thread::hardware_concurrency());
+    std::thread computeStage = runStage(triangulators, [&]() {
+        setTraceThreadName("triangulator");
+        std::unique_ptr<Job> job;
+        while (loaded.pop(job)) {
+            job->triangles = delaunayTriangulationIndexed(job->cloud->points());
+            triangulated.push(std::move(job));
+        }
+    }, [&]() { triangulated.close(); });
+
+    std::thread writeStage = runStage(options.writers, [&]() {
+        setTraceThreadName("writer");
+        std::unique_ptr<Job> job;
+        while (triangulated.pop(job)) {
+            if (!exportMesh(job->cloud->points(), job->triangles, job->cloud->attributes, job->output,
+                            options.exportOptions)) {
+                ++failed;
+                continue;
+            }
+            points += job->cloud->count;
+            triangles += job->triangles.size();
+        }
+    }, []() {});
+
+    readStage.join();
+    computeStage.join();
+    writeStage.join();
+
+    if (stats) {
+        stats->files = inputs.size();
+        stats->failed = failed;
+        stats->points = points;
+        stats->triangles = triangles;
+        stats->seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    }
+    return failed == 0;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// Latency histogram with power-of-two microsecond buckets; recording is lock-free
+class LatencyHistogram {
+public:
+    static const int bucketCount = 40;
+
+    LatencyHistogram() {
+        for (auto& b : buckets) b = 0;
+        maxMicros = 0;
+    }
+
+    void record(double seconds) {
+        uint64_t micros = static_cast<uint64_t>(seconds * 1e6);
+        int bucket = 0;
+        while (bucket + 1 < bucketCount && (uint64_t(1) << bucket) <= micros) ++bucket;
+        ++buckets[bucket];
+        uint64_t seen = maxMicros;
+        while (micros > seen && !maxMicros.compare_exchange_weak(seen, micros)) {}
+    }
+
+    // Upper bound of the bucket holding quantile q, in microseconds
+    uint64_t quantile(double q) const {
+        uint64_t total = count(), seen = 0;
+        for (int b = 0; b < bucketCount; ++b) {
+            seen += buckets[b];
+            if (total && seen >= q * total) return std::min<uint64_t>(uint64_t(1) << b, maxMicros);
+        }
+        return maxMicros;
+    }
+
+    uint64_t count() const {
+        uint64_t total = 0;
+        for (const auto& b : buckets) total += b;
+        return total;
+    }
+
+    std::string summary() const {
+        std::ostringstream out;
+        out << "n=" << count() << " p50<=" << quantile(0.5) << "us p90<=" << quantile(0.9) << "us p99<="
+            << quantile(0.99) << "us max=" << maxMicros << "us";
+        return out.str();
+    }
+
+private:
+    std::atomic<uint64_t> buckets[bucketCount];
+    std::atomic<uint64_t> maxMicros;
+};
+
+// Wire format of the triangulation daemon (native byte order, the socket is local). A request is a header
+// followed by count Points; the response is a header followed by count IndexedTriangles, or by count bytes of
+// text for a stats request.
+struct DaemonHeader {
+    uint32_t magic;
+    int32_t code;    // request: DaemonRequestType; response: DaemonStatus
+    uint64_t count;
+};
+
+static_assert(sizeof(DaemonHeader) == 16, "daemon header layout");
+
+const uint32_t daemonMagic = 0x514e4c44;  // "DLNQ"
+
+enum DaemonRequestType { daemonTriangulate = 0, daemonStats = 1 };
+enum DaemonStatus { daemonOk = 0, daemonBadRequest = 1, daemonBusy = 2 };
+
+// Options for the triangulation daemon
+struct DaemonOptions {
+    unsigned workers;               // 0 = one per hardware thread
+    size_t queueDepth;              // requests waiting for a worker
+    size_t maxBatch;                // requests a worker takes from the queue at once
+    unsigned maxClients;            // further connections wait in the listen backlog
+    unsigned busyTimeoutMs;         // a request is answered daemonBusy after waiting this long for queue space
+    uint64_t maxPointsPerRequest;
+
+    DaemonOptions() : workers(0), queueDepth(256), maxBatch(32), maxClients(64), busyTimeoutMs(1000),
+                      maxPointsPerRequest(uint64_t(1) << 26) {}
+};
+
+static bool readFully(int fd, void* data, size_t size) {
+    char* p = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t n = ::read(fd, p, size);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        size -= n;
+    }
+    return true;
+}
+
+// Write a header and payload with as few system calls as possible
+static bool writeMessage(int fd, const DaemonHeader& header, const void* payload, size_t size) {
+    iovec iov[2];
+    iov[0].iov_base = const_cast<DaemonHeader*>(&header);
+    iov[0].iov_len = sizeof(header);
+    iov[1].iov_base = const_cast<void*>(payload);
+    iov[1].iov_len = size;
+    iovec* next = iov;
+    int remaining = size ? 2 : 1;
+    while (remaining > 0) {
+        ssize_t n = ::writev(fd, next, remaining);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        while (remaining > 0 && static_cast<size_t>(n) >= next->iov_len) {
+            n -= next->iov_len;
+            ++next;
+            --remaining;
+        }
+        if (remaining > 0) {
+            next->iov_base = static_cast<char*>(next->iov_base) + n;
+            next->iov_len -= n;
+        }
+    }
+    return true;
+}
+
+static volatile sig_atomic_t daemonStopRequested = 0;
+
+static void requestDaemonStop(int) { daemonStopRequested = 1; }
+
+// Serve triangulation requests on a Unix domain socket until SIGINT or SIGTERM. Each connection has a reader
+// thread that receives point buffers and queues them; a pool of workers takes requests from the queue in
+// batches and triangulates them with per-worker scratch. The bounded queue provides backpressure: a reader
+// waits for space, which stops it reading its socket, and answers daemonBusy if the wait exceeds the timeout.
+// Queue wait, compute and end-to-end latencies are kept in histograms, returned by stats requests and
+// printed on shutdown.
+bool runDaemon(const std::string& socketPath, const DaemonOptions& options = DaemonOptions()) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: Socket path too long: " << socketPath << std::endl;
+        return false;
+    }
+    std::strcpy(address.sun_path, socketPath.c_str());
+    int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ::unlink(socketPath.c_str());
+    if (listener < 0 || ::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, 128) != 0) {
+        std::cerr << "Error: Could not listen on " << socketPath << ": " << std::strerror(errno) << std::endl;
+        if (listener >= 0) ::close(listener);
+        return false;
+    }
+    daemonStopRequested = 0;
+    ::signal(SIGINT, requestDaemonStop);
+    ::signal(SIGTERM, requestDaemonStop);
+    ::signal(SIGPIPE, SIG_IGN);
+
+    typedef std::chrono::steady_clock Clock;
+    struct Request {
+        std::vector<Point> points;
+        std::vector<IndexedTriangle> triangles;
+        Clock::time_point received, started, finished;
+        bool done;
+        std::mutex mutex;
+        std::condition_variable finishedSignal;
+    };
+    BoundedQueue<Request*> queue(options.queueDepth);
+    LatencyHistogram queueLatency, computeLatency, totalLatency;
+    std::atomic<uint64_t> served(0), rejected(0), batches(0);
+
+    auto statsText = [&]() {
+        std::ostringstream out;
+        out << "served " << served << ", rejected " << rejected << ", batches " << batches << "\n"
+            << "queue   " << queueLatency.summary() << "\n"
+            << "compute " << computeLatency.summary() << "\n"
+            << "total   " << totalLatency.summary() << "\n";
+        return out.str();
+    };
+
+    unsigned workerCount = options.workers ? options.workers : std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> workers;
+    for (unsigned w = 0; w < workerCount; ++w) {
+        workers.emplace_back([&]() {
+            TriangulationScratch scratch;
+            std::vector<Request*> batch;
+            setTraceThreadName("daemon worker");
+            while (queue.popBatch(batch, std::max<size_t>(1, options.maxBatch))) {
+                TRACE_SCOPE("request_batch");
+                ++batches;
+                for (Request* request : batch) {
+                    request->started = Clock::now();
+                    if (request->points.size() >= 3) {
+                        delaunayTriangulationIndexed(request->points, request->triangles, scratch);
+                    } else {
+                        request->triangles.clear();
+                    }
+                    request->finished = Clock::now();
+                    std::lock_guard<std::mutex> lock(request->mutex);
+                    request->done = true;
+                    request->finishedSignal.notify_one();
+                }
+            }
+        });
+    }
+
+    // Connections are served by their own reader thread; finished ones are joined by the accept loop
+    std::mutex clientsMutex;
+    std::map<int, std::thread> clients;
+    std::vector<int> finishedClients;
+    auto serveClient = [&](int fd) {
+        Request request;
+        DaemonHeader header;
+        while (readFully(fd, &header, sizeof(header))) {
+            DaemonHeader response;
+            response.magic = daemonMagic;
+            response.count = 0;
+            bool valid = header.magic == daemonMagic;
+            if (valid && header.code == daemonStats) {
+                std::string text = statsText();
+                response.code = daemonOk;
+                response.count = text.size();
+                if (!writeMessage(fd, response, text.data(), text.size())) break;
+                continue;
+            }
+            valid = valid && header.code == daemonTriangulate && header.count <= options.maxPointsPerRequest;
+            if (!valid) {
+                response.code = daemonBadRequest;
+                writeMessage(fd, response, nullptr, 0);
+                break;
+            }
+            request.points.resize(header.count);
+            if (!readFully(fd, request.points.data(), header.count * sizeof(Point))) break;
+            request.received = Clock::now();
+            request.done = false;
+            Request* queued = &request;
+            if (!queue.tryPush(queued, std::chrono::milliseconds(options.busyTimeoutMs))) {
+                ++rejected;
+                response.code = daemonBusy;
+                if (!writeMessage(fd, response, nullptr, 0)) break;
+                continue;
+            }
+            {
+                std::unique_lock<std::mutex> lock(request.mutex);
+                request.finishedSignal.wait(lock, [&] { return request.done; });
+            }
+            response.code = daemonOk;
+            response.count = request.triangles.size();
+            bool sent = writeMessage(fd, response, request.triangles.data(),
+                                     request.triangles.size() * sizeof(IndexedTriangle));
+            std::chrono::duration<double> waited = request.started - request.received;
+            std::chrono::duration<double> computed = request.finished - request.started;
+            std::chrono::duration<double> total = Clock::now() - request.received;
+            queueLatency.record(waited.count());
+            computeLatency.record(computed.count());
+            totalLatency.record(total.count());
+            ++served;
+            if (!sent) break;
+        }
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        finishedClients.push_back(fd);
+    };
+    auto joinFinished = [&]() {
+        std::vector<std::thread> done;
+        std::vector<int> doneFds;
+        {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            for (int fd : finishedClients) {
+                done.push_back(std::move(clients[fd]));
+                clients.erase(fd);
+            }
+            doneFds.swap(finishedClients);
+        }
+        // Sockets are closed only after their reader exits, so shutdown never hits a reused descriptor
+        for (auto& t : done) t.join();
+        for (int fd : doneFds) ::close(fd);
+    };
+
+    std::cout << "Listening on " << socketPath << " with " << workerCount << " workers." << std::endl;
+    while (!daemonStopRequested) {
+        joinFinished();
+        size_t active;
+        {
+            std::lock_guard<std::mutex> lock(clientsMutex);
+            active = clients.size();
+        }
+        pollfd watch;
+        watch.fd = listener;
+        watch.events = active < options.maxClients ? POLLIN : 0;
+        watch.revents = 0;
+        if (::poll(&watch, 1, 100) <= 0 || !(watch.revents & POLLIN)) continue;
+        int fd = ::accept(listener, nullptr, nullptr);
+        if (fd < 0) continue;
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        clients[fd] = std::thread(serveClient, fd);
+    }
+
+    // Wake readers blocked on their sockets, let queued requests finish, then stop the workers
+    ::close(listener);
+    ::unlink(socketPath.c_str());
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        for (auto& client : clients) ::shutdown(client.first, SHUT_RDWR);
+    }
+    for (;;) {
+        joinFinished();
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        if (clients.empty()) break;
+    }
+    queue.close();
+    for (auto& t : workers) t.join();
+    std::cout << statsText();
+    return true;
+}
+
+// Client side of the daemon protocol; one connection carries any number of requests
+class TriangulationClient {
+public:
+    TriangulationClient() : fd(-1) {}
+    ~TriangulationClient() { close(); }
+
+    bool connect(const std::string& socketPath) {
+        close();
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (socketPath.size() >= sizeof(address.sun_path)) return false;
+        std::strcpy(address.sun_path, socketPath.c_str());
+        fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            std::cerr << "Error: Could not connect to " << socketPath << std::endl;
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+    }
+
+    // Returns the daemon status, or -1 if the connection failed
+    int triangulate(PointSpan points, std::vector<IndexedTriangle>& triangles) {
+        DaemonHeader header;
+        header.magic = daemonMagic;
+        header.code = daemonTriangulate;
+        header.count = points.size();
+        if (!writeMessage(fd, header, points.begin(), points.size() * sizeof(Point))) return -1;
+        if (!readFully(fd, &header, sizeof(header)) || header.magic != daemonMagic) return -1;
+        triangles.resize(header.code == daemonOk ? header.count : 0);
+        if (!readFully(fd, triangles.data(), triangles.size() * sizeof(IndexedTriangle))) return -1;
+        return header.code;
+    }
+
+    // Latency histograms and counters of the daemon as text
+    std::string stats() {
+        DaemonHeader header;
+        header.magic = daemonMagic;
+        header.code = daemonStats;
+        header.count = 0;
+        std::string text;
+        if (!writeMessage(fd, header, nullptr, 0) || !readFully(fd, &header, sizeof(header))) return text;
+        text.resize(header.count);
+        if (!readFully(fd, &text[0], text.size())) text.clear();
+        return text;
+    }
+
+private:
+    int fd;
+};
+#endif
+
+// Exact geometric predicates (Shewchuk-style). A floating-point filter with a proven error bound decides
+// almost every call; only near-degenerate inputs fall back to exact expansion arithmetic, where a value is
+// an unevaluated sum of non-overlapping doubles.
+typedef std::vector<double> Expansion;
+
+static void twoSum(double a, double b, double& sum, double& error) {
+    sum = a + b;
+    double bVirtual = sum - a;
+    double aVirtual = sum - bVirtual;
+    error = (a - aVirtual) + (b - bVirtual);
+}
+
+static void twoProduct(double a, double b, double& product, double& error) {
+    product = a * b;
+    error = std::fma(a, b, -product);
+}
+
+// e + b, dropping zero components
+static Expansion growExpansion(const Expansion& e, double b) {
+    Expansion h;
+    double q = b;
+    for (double component : e) {
+        double error;
+        twoSum(q, component, q, error);
+        if (error != 0.0) h.push_back(error);
+    }
+    if (q != 0.0 || h.empty()) h.push_back(q);
+    return h;
+}
+
+static Expansion sumExpansions(const Expansion& e, const Expansion& f) {
+    Expansion h = e;
+    for (double component : f) h = growExpansion(h, component);
+    return h;
+}
+
+static Expansion scaleExpansion(const Expansion& e, double b) {
+    Expansion h;
+    for (double component : e) {
+        double product, error;
+        twoProduct(component, b, product, error);
+        h = growExpansion(growExpansion(h, error), product);
+    }
+    return h;
+}
+
+static Expansion multiplyExpansions(const Expansion& e, const Expansion& f) {
+    Expansion h;
+    for (double component : f) h = sumExpansions(h, scaleExpansion(e, component));
+    return h;
+}
+
+static int expansionSign(const Expansion& e) {
+    for (size_t i = e.size(); i-- > 0;) {
+        if (e[i] != 0.0) return e[i] > 0.0 ? 1 : -1;
+    }
+    return 0;
+}
+
+// a.x * b.y - a.y * b.x exactly
+static Expansion exactCross(const Point& a, const Point& b) {
+    double p1, e1, p2, e2;
+    twoProduct(a.x, b.y, p1, e1);
+    twoProduct(-a.y, b.x, p2, e2);
+    return sumExpansions(Expansion{e1, p1}, Expansion{e2, p2});
+}
+
+static Expansion exactOrientExpansion(const Point& a, const Point& b, const Point& c) {
+    return sumExpansions(sumExpansions(exactCross(a, b), exactCross(b, c)), exactCross(c, a));
+}
+
+const double predicateEpsilon = 1.1102230246251565e-16;  // 2^-53
+const double orientErrorBound = (3.0 + 16.0 * predicateEpsilon) * predicateEpsilon;
+const double inCircleErrorBound = (10.0 + 96.0 * predicateEpsilon) * predicateEpsilon;
+
+// Sign of the signed area of abc: +1 counter-clockwise, -1 clockwise, 0 collinear; always correct
+int exactOrient2d(const Point& a, const Point& b, const Point& c) {
+    double left = (a.x - c.x) * (b.y - c.y);
+    double right = (a.y - c.y) * (b.x - c.x);
+    double det = left - right;
+    double sum;
+    if (left > 0.0) {
+        if (right <= 0.0) return det > 0.0 ? 1 : (det < 0.0 ? -1 : 0);
+        sum = left + right;
+    } else if (left < 0.0) {
+        if (right >= 0.0) return det > 0.0 ? 1 : (det < 0.0 ? -1 : 0);
+        sum = -left - right;
+    } else {
+        return det > 0.0 ? 1 : (det < 0.0 ? -1 : 0);
+    }
+    double bound = orientErrorBound * sum;
+    if (det > bound) return 1;
+    if (-det > bound) return -1;
+    return expansionSign(exactOrientExpansion(a, b, c));
+}
+
+// +1 if d lies inside the circumcircle of the counter-clockwise triangle abc, -1 outside, 0 on it; always correct
+int exactInCircle(const Point& a, const Point& b, const Point& c, const Point& d) {
+    double adx = a.x - d.x, ady = a.y - d.y;
+    double bdx = b.x - d.x, bdy = b.y - d.y;
+    double cdx = c.x - d.x, cdy = c.y - d.y;
+    double bc = bdx * cdy - cdx * bdy, ca = cdx * ady - adx * cdy, ab = adx * bdy - bdx * ady;
+    double alift = adx * adx + ady * ady, blift = bdx * bdx + bdy * bdy, clift = cdx * cdx + cdy * cdy;
+    double det = alift * bc + blift * ca + clift * ab;
+    double permanent = (std::fabs(bdx * cdy) + std::fabs(cdx * bdy)) * alift +
+                       (std::fabs(cdx * ady) + std::fabs(adx * cdy)) * blift +
+                       (std::fabs(adx * bdy) + std::fabs(bdx * ady)) * clift;
+    double bound = inCircleErrorBound * permanent;
+    if (det > bound) return 1;
+    if (-det > bound) return -1;
+
+    // Exact: expand the lifted 4x4 determinant along the lift column using untranslated coordinates
+    auto lift = [](const Point& p) {
+        double x2, ex, y2, ey;
+        twoProduct(p.x, p.x, x2, ex);
+        twoProduct(p.y, p.y, y2, ey);
+        return sumExpansions(Expansion{ex, x2}, Expansion{ey, y2});
+    };
+    auto negate = [](Expansion e) {
+        for (double& component : e) component = -component;
+        return e;
+    };
+    Expansion total = multiplyExpansions(lift(a), exactOrientExpansion(b, c, d));
+    total = sumExpansions(total, negate(multiplyExpansions(lift(b), exactOrientExpansion(a, c, d))));
+    total = sumExpansions(total, multiplyExpansions(lift(c), exactOrientExpansion(a, b, d)));
+    total = sumExpansions(total, negate(multiplyExpansions(lift(d), exactOrientExpansion(a, b, c))));
+    return expansionSign(total);
+}
+
+// Outcome of validateTriangulation; counts are of offending elements
+struct ValidationReport {
+    size_t points, triangles;
+    size_t clockwise, degenerate;   // triangles with negative or zero exact area
+    size_t badIndices;              // triangles referencing a vertex outside the point set
+    size_t duplicateEdges;          // directed edges used by more than one triangle
+    size_t nonDelaunayEdges;        // interior edges whose opposite vertex is strictly inside the circumcircle
+    size_t missingPoints;           // input points that are not vertices (and do not duplicate a vertex)
+    size_t duplicatePoints;         // input points equal to another point that is a vertex
+    size_t boundaryEdges, boundaryLoops;
+    size_t pinchedVertices;         // vertices where the boundary touches itself
+    size_t reflexBoundaryVertices;  // boundary turns right, so the mesh does not fill the convex hull
+    bool eulerCountMatches;         // triangles == 2 * vertices - 2 - boundary vertices
+    bool allowReflexBoundary;       // opt-out: report reflex boundary vertices as a warning only
+
+    bool valid() const {
+        return clockwise == 0 && degenerate == 0 && badIndices == 0 && duplicateEdges == 0 &&
+               nonDelaunayEdges == 0 && missingPoints == 0 && pinchedVertices == 0 &&
+               (reflexBoundaryVertices == 0 || allowReflexBoundary) &&
+               (triangles == 0 || (boundaryLoops == 1 && eulerCountMatches));
+    }
+
+    void write(std::ostream& out) const {
+        out << "Validation " << (valid() ? "passed" : "FAILED") << ": " << triangles << " triangles, " << points
+            << " points; " << clockwise << " clockwise, " << degenerate << " degenerate, " << badIndices
+            << " bad indices, " << duplicateEdges << " duplicate edges, " << nonDelaunayEdges
+            << " non-Delaunay edges, " << missingPoints << " missing points, " << duplicatePoints
+            << " duplicate points, " << boundaryEdges << " boundary edges in " << boundaryLoops << " loop(s), "
+            << pinchedVertices << " pinched and " << reflexBoundaryVertices << " reflex boundary vertices, Euler count "
+            << (eulerCountMatches ? "matches" : "does NOT match") << "." << std::endl;
+        if (reflexBoundaryVertices > 0 && allowReflexBoundary) {
+            out << "Warning: " << reflexBoundaryVertices
+                << " reflex boundary vertices; the mesh does not cover the whole convex hull." << std::endl;
+        }
+    }
+};
+
+// Check that triangles form the Delaunay triangulation of points using exact predicates: every triangle is
+// counter-clockwise, every directed edge is used once, every interior edge is locally Delaunay (which for a
+// triangulation implies the whole mesh is Delaunay), the boundary is one convex loop with the Euler triangle
+// count (so the mesh covers the convex hull exactly once) and every input point is a vertex. Half-edges are
+// matched through per-vertex adjacency lists, so the work is O(n); the predicate checks run in parallel.
+ValidationReport validateTriangulation(PointSpan points, const std::vector<IndexedTriangle>& triangles,
+                                       unsigned numThreads = 0) {
+    ValidationReport report;
+    std::memset(&report, 0, sizeof(report));
+    report.points = points.size();
+    report.triangles = triangles.size();
+    const size_t n = points.size(), m = triangles.size();
+    auto vertexOf = [&](size_t half) { return (&triangles[half / 3].a)[half % 3]; };
+    auto nextOf = [](size_t half) { return half - half % 3 + (half % 3 + 1) % 3; };
+
+    for (const auto& t : triangles) {
+        if (t.a < 0 || t.b < 0 || t.c < 0 || size_t(t.a) >= n || size_t(t.b) >= n || size_t(t.c) >= n) {
+            ++report.badIndices;
+        }
+    }
+    if (report.badIndices) return report;
+
+    // Outgoing half-edges grouped by origin vertex (counting sort)
+    std::vector<size_t> start(n + 1, 0), outgoing(3 * m);
+    for (size_t h = 0; h < 3 * m; ++h) ++start[vertexOf(h) + 1];
+    for (size_t v = 0; v < n; ++v) start[v + 1] += start[v];
+    {
+        std::vector<size_t> fill(start.begin(), start.end() - 1);
+        for (size_t h = 0; h < 3 * m; ++h) outgoing[fill[vertexOf(h)]++] = h;
+    }
+    std::vector<int64_t> twin(3 * m, -1);
+    AccountedBytes adjacencyBytes(memoryAdjacency,
+                                  capacityBytes(start) + capacityBytes(outgoing) + capacityBytes(twin));
+
+    const size_t chunk = 4096;
+    std::vector<ValidationReport> partial((m + chunk - 1) / chunk);
+    parallelFor(partial.size(), numThreads, [&](size_t k) {
+        ValidationReport& r = partial[k];
+        std::memset(&r, 0, sizeof(r));
+        for (size_t t = k * chunk; t < std::min(m, (k + 1) * chunk); ++t) {
+            const IndexedTriangle& tri = triangles[t];
+            int orientation = exactOrient2d(points[tri.a], points[tri.b], points[tri.c]);
+            if (orientation < 0) ++r.clockwise;
+            if (orientation == 0) ++r.degenerate;
+            for (size_t h = 3 * t; h < 3 * t + 3; ++h) {
+                int from = vertexOf(h), to = vertexOf(nextOf(h));
+                // A directed edge held by several half-edges is counted once, at its lowest holder
+                bool earlier = false, later = false;
+                for (size_t i = start[from]; i < start[from + 1]; ++i) {
+                    size_t other = outgoing[i];
+                    if (other == h || vertexOf(nextOf(other)) != to) continue;
+                    (other < h ? earlier : later) = true;
+                }
+                if (!earlier && later) ++r.duplicateEdges;
+                for (size_t i = start[to]; i < start[to + 1]; ++i) {
+                    size_t other = outgoing[i];
+                    if (vertexOf(nextOf(other)) != from) continue;
+                    twin[h] = static_cast<int64_t>(other);
+                    // Check each interior edge once, from its lower half-edge
+                    if (h < other) {
+                        const Point& opposite = points[vertexOf(nextOf(nextOf(other)))];
+                        if (exactInCircle(points[tri.a], points[tri.b], points[tri.c], opposite) > 0) {
+                            ++r.nonDelaunayEdges;
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+    });
+    for (const auto& r : partial) {
+        report.clockwise += r.clockwise;
+        report.degenerate += r.degenerate;
+        report.duplicateEdges += r.duplicateEdges;
+        report.nonDelaunayEdges += r.nonDelaunayEdges;
+    }
+
+    // Boundary: half-edges without a twin must chain into one loop that only turns left
+    std::vector<int> boundaryNext(n, -1);
+    for (size_t h = 0; h < 3 * m; ++h) {
+        if (twin[h] >= 0) continue;
+        ++report.boundaryEdges;
+        int from = vertexOf(h);
+        if (boundaryNext[from] >= 0) ++report.pinchedVertices;
+        boundaryNext[from] = vertexOf(nextOf(h));
+    }
+    std::vector<char> visited(n, 0);
+    for (size_t first = 0; first < n; ++first) {
+        if (boundaryNext[first] < 0 || visited[first]) continue;
+        ++report.boundaryLoops;
+        for (int v = static_cast<int>(first); v >= 0 && !visited[v]; v = boundaryNext[v]) {
+            visited[v] = 1;
+            int next = boundaryNext[v];
+            int after = next >= 0 ? boundaryNext[next] : -1;
+            if (after >= 0 && exactOrient2d(points[v], points[next], points[after]) < 0) {
+                ++report.reflexBoundaryVertices;
+            }
+        }
+    }
+
+    // Every input point must be a vertex; an unused point equal to a vertex is a tolerated duplicate
+    std::vector<char> used(n, 0);
+    size_t vertexCount = 0;
+    for (const auto& t : triangles) {
+        for (int v : {t.a, t.b, t.c}) {
+            vertexCount += !used[v];
+            used[v] = 1;
+        }
+    }
+    PointIndexMap vertices(vertexCount);
+    for (size_t i = 0; i < n; ++i) {
+        if (used[i]) vertices.findOrInsert(points[i], static_cast<int>(i));
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (used[i]) continue;
+        if (vertices.findOrInsert(points[i], static_cast<int>(i)) != static_cast<int>(i)) {
+            ++report.duplicatePoints;
+        } else {
+            ++report.missingPoints;
+        }
+    }
+    report.eulerCountMatches = static_cast<int64_t>(m) ==
+                               2 * static_cast<int64_t>(vertexCount) - 2 - static_cast<int64_t>(report.boundaryEdges);
+    return report;
+}
+
+// Deterministic generator for benchmark inputs (the same points on every platform)
+struct BenchmarkRandom {
+    uint64_t state;
+
+    explicit BenchmarkRandom(uint64_t seed) : state(seed) {}
+
+    uint64_t next() { return mix64(state += 0x9e3779b97f4a7c15ull); }
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // Standard normal sample (Box-Muller)
+    double normal() {
+        double u = 1.0 - uniform(), v = uniform();
+        return std::sqrt(-2.0 * std::log(u)) * std::cos(6.283185307179586 * v);
+    }
+};
+
+const char* const benchmarkDistributions[] = {"uniform", "gaussian", "clustered", "grid", "cocircular", "collinear",
+                                              "airfoil"};
+
+// Generate n points of a named distribution in roughly the unit square; empty for an unknown name
+std::vector<Point> generateBenchmarkPoints(const std::string& distribution, size_t n, uint64_t seed = 1) {
+    BenchmarkRandom random(seed);
+    std::vector<Point> points;
+    points.reserve(n);
+    if (distribution == "uniform") {
+        for (size_t i = 0; i < n; ++i) points.push_back({random.uniform(), random.uniform()});
+    } else if (distribution == "gaussian") {
+        for (size_t i = 0; i < n; ++i) points.push_back({0.5 + 0.15 * random.normal(), 0.5 + 0.15 * random.normal()});
+    } else if (distribution == "clustered") {
+        // Tight Gaussian clusters around random centres, with sizes drawn uniformly
+        std::vector<Point> centres;
+        size_t clusters = std::max<size_t>(1, n / 1000);
+        for (size_t c = 0; c < clusters; ++c) centres.push_back({random.uniform(), random.uniform()});
+        for (size_t i = 0; i < n; ++i) {
+            const Point& centre = centres[random.next() % clusters];
+            points.push_back({centre.x + 0.01 * random.normal(), centre.y + 0.01 * random.normal()});
+        }
+    } else if (distribution == "grid") {
+        size_t side = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(n))));
+        for (size_t i = 0; i < n; ++i) points.push_back({double(i % side) / side, double(i / side) / side});
+    } else if (distribution == "cocircular") {
+        // Concentric circles, each with many exactly co-circular points
+        size_t perCircle = std::max<size_t>(3, static_cast<size_t>(std::sqrt(static_cast<double>(n))));
+        for (size_t i = 0; i < n; ++i) {
+            double radius = 0.05 + 0.45 * double(i / perCircle + 1) / (n / perCircle + 1);
+            double angle = 6.283185307179586 * double(i % perCircle) / perCircle;
+            points.push_back({0.5 + radius * std::cos(angle), 0.5 + radius * std::sin(angle)});
+        }
+    } else if (distribution == "collinear") {
+        // Nine points in ten lie on a few horizontal and diagonal lines
+        for (size_t i = 0; i < n; ++i) {
+            double t = random.uniform();
+            uint64_t line = random.next() % 10;
+            if (line == 9) {
+                points.push_back({t, random.uniform()});
+            } else if (line < 5) {
+                points.push_back({t, 0.1 + 0.2 * line});
+            } else {
+                points.push_back({t, t * 0.25 * (line - 4)});
+            }
+        }
+    } else if (distribution == "airfoil") {
+        // NACA 0012 section with boundary-layer points graded away from the surface and a sparse far field
+        for (size_t i = 0; i < n; ++i) {
+            if (random.next() % 5 == 0) {
+                points.push_back({-1.0 + 3.0 * random.uniform(), -1.5 + 3.0 * random.uniform()});
+                continue;
+            }
+            double x = 0.5 * (1.0 - std::cos(3.141592653589793 * random.uniform()));
+            double thickness = 0.6 * (0.2969 * std::sqrt(x) - 0.126 * x - 0.3516 * x * x + 0.2843 * x * x * x -
+                                      0.1015 * x * x * x * x);
+            double layer = 1e-4 * (std::pow(1.2, static_cast<double>(random.next() % 40)) - 1.0);
+            double side = random.next() % 2 ? 1.0 : -1.0;
+            points.push_back({x, side * (thickness + layer)});
+        }
+    }
+    return points;
+}
+
+// Peak resident set size of this process in KiB
+static size_t peakRSSKiB() {
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::strtoull(line.c_str() + 6, nullptr, 10);
+    }
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage;
+    if (::getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+    }
+#endif
+    return 0;
+}
+
+// Reset the peak RSS to the current RSS where the kernel allows it, so each run reports its own peak
+static void resetPeakRSS() {
+#if defined(__linux__)
+    std::ofstream clear("/proc/self/clear_refs");
+    clear << "5";
+#endif
+}
+
+// Options for the benchmark suite
+struct BenchmarkOptions {
+    std::vector<std::string> distributions;
+    std::vector<std::string> engines;  // indexed, float32, index64, tiled, sharded, streaming
+    size_t minPoints, maxPoints;
+    double sizeFactor;                 // growth between sizes
+    int repetitions;
+    double budgetSeconds;              // a size is skipped when its predicted run time exceeds this
+    std::string scratchPrefix;         // files written by the streaming engine
+
+    BenchmarkOptions()
+        : distributions(std::begin(benchmarkDistributions), std::end(benchmarkDistributions)),
+          engines({"indexed", "float32", "index64", "tiled", "sharded", "streaming"}), minPoints(1000),
+          maxPoints(100000000), sizeFactor(10.0), repetitions(5), budgetSeconds(30.0),
+          scratchPrefix("benchmark-stream") {}
+};
+
+// One benchmark measurement: an engine on a distribution at one size
+struct BenchmarkResult {
+    std::string engine, distribution;
+    size_t points, triangles;
+    int repetitions;
+    double minSeconds, medianSeconds, meanSeconds;
+    double pointsPerSecond;  // from the median
+    double scalingExponent;  // log-log slope of the median against the previous size, 0 for the first
+    size_t peakRSSKiB;
+    bool verified;           // false if a tiled or sharded merge failed its check, or kept no tile triangle of a grid
+    std::vector<double> samples;  // seconds of each repetition, sorted
+};
+
+// Run one engine once; returns the triangle count, or SIZE_MAX if the engine failed
+static size_t runBenchmarkEngine(const std::string& engine, const std::string& distribution, PointSpan points,
+                                 const std::string& scratchPrefix, bool& verified) {
+    verified = true;
+    if (engine == "indexed") return delaunayTriangulationIndexed(points).size();
+    if (engine == "index64") return delaunayTriangulationIndexed<double, int64_t>(points).size();
+    if (engine == "float32") {
+        std::vector<BasicPoint<float>> narrowed(points.size());
+        for (size_t i = 0; i < points.size(); ++i) {
+            narrowed[i] = {static_cast<float>(points[i].x), static_cast<float>(points[i].y)};
+        }
+        return delaunayTriangulationIndexed<float, int>(BasicPointSpan<float>(narrowed)).size();
+    }
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    int tiles = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(threads)))));
+    TilingStats tiling;
+    if (engine == "tiled" || engine == "sharded") {
+        size_t triangles = engine == "tiled" ? tiledDelaunayTriangulation(points, tiles, tiles, 0, &tiling).size()
+                                             : shardedDelaunayTriangulation(points, ShardingOptions(), &tiling).size();
+        // Every tile of a grid has interior triangles to keep; keeping none means the seam pass redid the input
+        verified = tiling.verified && (distribution != "grid" || tiling.safeTriangles > 0);
+        return triangles;
+    }
+    if (engine == "streaming") {
+        StreamingStats stats;
+        bool ok = streamingDelaunayTriangulation(points, scratchPrefix, StreamingOptions(), &stats);
+        std::remove((scratchPrefix + ".vertices").c_str());
+        std::remove((scratchPrefix + ".triangles").c_str());
+        return ok ? stats.triangles : SIZE_MAX;
+    }
+    std::cerr << "Error: Unknown engine " << engine << std::endl;
+    return SIZE_MAX;
+}
+
+// Time repetitions of one engine on one input; false if the engine failed
+static bool measureBenchmark(const std::string& engine, const std::string& distribution, PointSpan points,
+                             int repetitions, const std::string& scratchPrefix, BenchmarkResult& result) {
+    result.engine = engine;
+    result.distribution = distribution;
+    result.points = points.size();
+    result.triangles = 0;
+    result.verified = true;
+    result.repetitions = std::max(1, repetitions);
+    result.scalingExponent = 0.0;
+    result.samples.clear();
+    resetPeakRSS();
+    for (int r = 0; r < result.repetitions; ++r) {
+        auto start = std::chrono::high_resolution_clock::now();
+        bool verified = true;
+        result.triangles = runBenchmarkEngine(engine, distribution, points, scratchPrefix, verified);
+        result.verified = result.verified && verified;
+        result.samples.push_back(std::chrono::duration<double>(std::chrono::high_resolution_clock::now() -
+                                                               start).count());
+        if (result.triangles == SIZE_MAX) return false;
+    }
+    result.peakRSSKiB = peakRSSKiB();
+    std::vector<double>& seconds = result.samples;
+    std::sort(seconds.begin(), seconds.end());
+    result.minSeconds = seconds.front();
+    result.medianSeconds = seconds.size() % 2 ? seconds[seconds.size() / 2]
+                                              : 0.5 * (seconds[seconds.size() / 2 - 1] + seconds[seconds.size() / 2]);
+    double total = 0;
+    for (double t : seconds) total += t;
+    result.meanSeconds = total / seconds.size();
+    result.pointsPerSecond = points.size() / std::max(result.medianSeconds, 1e-12);
+    return true;
+}
+
+// Time every engine on every distribution over growing sizes. Each series stops growing once the run time
+// predicted from its measured scaling exceeds the budget, so slow engines do not stall the suite.
+std::vector<BenchmarkResult> runBenchmarks(const BenchmarkOptions& options = BenchmarkOptions()) {
+    std::vector<BenchmarkResult> results;
+    for (const auto& distribution : options.distributions) {
+        std::vector<bool> stopped(options.engines.size(), false);
+        for (double size = static_cast<double>(options.minPoints); size <= options.maxPoints * 1.000001;
+             size *= options.sizeFactor) {
+            size_t n = static_cast<size_t>(size + 0.5);
+            std::vector<Point> points;
+            for (size_t e = 0; e < options.engines.size(); ++e) {
+                if (stopped[e]) continue;
+                const BenchmarkResult* previous = nullptr;
+                for (const auto& r : results) {
+                    if (r.engine == options.engines[e] && r.distribution == distribution) previous = &r;
+                }
+                if (previous) {
+                    double exponent = std::max(1.0, previous->scalingExponent);
+                    double predicted = previous->medianSeconds * std::pow(double(n) / previous->points, exponent);
+                    if (predicted * options.repetitions > options.budgetSeconds) {
+                        stopped[e] = true;
+                        continue;
+                    }
+                }
+                if (points.empty()) points = generateBenchmarkPoints(distribution, n);
+                if (points.empty()) break;
+
+                BenchmarkResult result;
+                if (!measureBenchmark(options.engines[e], distribution, points, options.repetitions,
+                                      options.scratchPrefix, result)) {
+                    stopped[e] = true;
+                    continue;
+                }
+                if (previous) {
+                    result.scalingExponent = std::log(result.medianSeconds / previous->medianSeconds) /
+                                             std::log(double(n) / previous->points);
+                }
+                std::cout << result.distribution << " " << result.engine << " " << n << " points: "
+                          << result.medianSeconds << " s median, " << result.pointsPerSecond << " points/s, peak "
+                          << result.peakRSSKiB << " KiB" << std::endl;
+                results.push_back(result);
+            }
+        }
+    }
+    return results;
+}
+
+// Write benchmark results as a JSON array of objects
+bool writeBenchmarkJSON(const std::string& filename, const std::vector<BenchmarkResult>& results) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+    file.precision(9);
+    file << "[\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        file << "  {\"engine\": \"" << r.engine << "\", \"distribution\": \"" << r.distribution
+             << "\", \"points\": " << r.points << ", \"triangles\": " << r.triangles
+             << ", \"repetitions\": " << r.repetitions << ", \"min_seconds\": " << r.minSeconds
+             << ", \"median_seconds\": " << r.medianSeconds << ", \"mean_seconds\": " << r.meanSeconds
+             << ", \"points_per_second\": " << r.pointsPerSecond << ", \"scaling_exponent\": " << r.scalingExponent
+             << ", \"peak_rss_kib\": " << r.peakRSSKiB << ", \"verified\": " << (r.verified ? "true" : "false")
+             << ", \"samples\": [";
+        for (size_t k = 0; k < r.samples.size(); ++k) file << (k ? ", " : "") << r.samples[k];
+        file << "]}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "]\n";
+    file.close();
+    std::cout << "Exported to " << filename << std::endl;
+    return true;
+}
+
+// Write benchmark results as CSV with a header row
+bool writeBenchmarkCSV(const std::string& filename, const std::vector<BenchmarkResult>& results) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+    file.precision(9);
+    file << "engine,distribution,points,triangles,repetitions,min_seconds,median_seconds,mean_seconds,"
+            "points_per_second,scaling_exponent,peak_rss_kib,verified\n";
+    for (const auto& r : results) {
+        file << r.engine << "," << r.distribution << "," << r.points << "," << r.triangles << "," << r.repetitions
+             << "," << r.minSeconds << "," << r.medianSeconds << "," << r.meanSeconds << "," << r.pointsPerSecond
+             << "," << r.scalingExponent << "," << r.peakRSSKiB << "," << (r.verified ? 1 : 0) << "\n";
+    }
+    file.close();
+    std::cout << "Exported to " << filename << std::endl;
+    return true;
+}
+
+// Read results written by writeBenchmarkJSON (a flat array of objects; unknown keys are ignored)
+bool readBenchmarkJSON(const std::string& filename, std::vector<BenchmarkResult>& results) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open file " << filename << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    const std::string text = buffer.str();
+    const char* p = text.c_str();
+    auto skip = [&]() { while (*p && std::isspace(static_cast<unsigned char>(*p))) ++p; };
+    auto expect = [&](char c) {
+        skip();
+        if (*p != c) return false;
+        ++p;
+        return true;
+    };
+    auto parseString = [&](std::string& out) {
+        if (!expect('"')) return false;
+        const char* end = std::strchr(p, '"');
+        if (!end) return false;
+        out.assign(p, end);
+        p = end + 1;
+        return true;
+    };
+    auto parseNumber = [&](double& out) {
+        skip();
+        char* end = nullptr;
+        out = std::strtod(p, &end);
+        if (end == p) return false;
+        p = end;
+        return true;
+    };
+
+    results.clear();
+    bool ok = expect('[');
+    skip();
+    if (ok && *p == ']') return true;
+    while (ok) {
+        BenchmarkResult r;
+        r.points = r.triangles = r.peakRSSKiB = 0;
+        r.repetitions = 0;
+        r.minSeconds = r.medianSeconds = r.meanSeconds = r.pointsPerSecond = r.scalingExponent = 0.0;
+        r.verified = true;
+        ok = expect('{');
+        while (ok) {
+            std::string key, value;
+            double number = 0;
+            ok = parseString(key) && expect(':');
+            if (!ok) break;
+            skip();
+            if (*p == '"') {
+                ok = parseString(value);
+                if (key == "engine") r.engine = value;
+                if (key == "distribution") r.distribution = value;
+            } else if (*p == '[') {
+                ++p;
+                skip();
+                while (ok && *p != ']') {
+                    ok = parseNumber(number);
+                    r.samples.push_back(number);
+                    skip();
+                    if (*p == ',') ++p;
+                    skip();
+                }
+                ok = ok && expect(']');
+            } else if (std::strncmp(p, "true", 4) == 0 || std::strncmp(p, "false", 5) == 0) {
+                bool flag = *p == 't';
+                p += flag ? 4 : 5;
+                if (key == "verified") r.verified = flag;
+            } else {
+                ok = parseNumber(number);
+                if (key == "points") r.points = static_cast<size_t>(number);
+                if (key == "triangles") r.triangles = static_cast<size_t>(number);
+                if (key == "repetitions") r.repetitions = static_cast<int>(number);
+                if (key == "min_seconds") r.minSeconds = number;
+                if (key == "median_seconds") r.medianSeconds = number;
+                if (key == "mean_seconds") r.meanSeconds = number;
+                if (key == "points_per_second") r.pointsPerSecond = number;
+                if (key == "scaling_exponent") r.scalingExponent = number;
+                if (key == "peak_rss_kib") r.peakRSSKiB = static_cast<size_t>(number);
+            }
+            skip();
+            if (*p == ',') {
+                ++p;
+                continue;
+            }
+            ok = ok && expect('}');
+            break;
+        }
+        if (!ok) break;
+        std::sort(r.samples.begin(), r.samples.end());
+        if (r.samples.empty()) r.samples.push_back(r.medianSeconds);
+        results.push_back(r);
+        skip();
+        if (*p == ',') {
+            ++p;
+            continue;
+        }
+        ok = expect(']');
+        break;
+    }
+    if (!ok) {
+        std::cerr << "Error: " << filename << " is not a benchmark results file" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Distribution-free confidence interval of the median from sorted samples: the order statistics
+// x(j) and x(n+1-j) for the largest j whose binomial coverage reaches the confidence level. With few
+// samples this is [min, max].
+static void medianConfidenceInterval(const std::vector<double>& sorted, double confidence, double& low,
+                                     double& high) {
+    const size_t n = sorted.size();
+    size_t j = 1;
+    double tail = std::pow(0.5, static_cast<double>(n));  // P(X <= j - 1) for X ~ Binomial(n, 1/2)
+    double term = tail;
+    for (size_t k = 1; k < n / 2; ++k) {
+        term *= double(n - k + 1) / k;
+        if (2.0 * (tail + term) > 1.0 - confidence) break;
+        tail += term;
+        j = k + 1;
+    }
+    low = sorted[j - 1];
+    high = sorted[n - j];
+}
+
+// Options for checkBenchmarkRegressions
+struct RegressionOptions {
+    double threshold;    // relative slowdown of the median that counts, e.g. 0.1 for 10%
+    double confidence;   // level of the median confidence intervals
+    int repetitions;     // 0 = as many as the baseline entry
+    std::string scratchPrefix;
+
+    RegressionOptions() : threshold(0.1), confidence(0.95), repetitions(0), scratchPrefix("regression-stream") {}
+};
+
+// Re-run every baseline measurement and compare. An entry regresses when its median is slower than the
+// baseline median by more than the threshold and the two median confidence intervals do not overlap, so
+// noise within the spread of either run is not reported. Prints one line per entry and returns false if
+// anything regressed, could no longer be run or failed its merge check.
+bool checkBenchmarkRegressions(const std::vector<BenchmarkResult>& baseline,
+                               const RegressionOptions& options = RegressionOptions(),
+                               std::vector<BenchmarkResult>* current = nullptr) {
+    size_t regressions = 0, improvements = 0;
+    std::string inputKey;
+    std::vector<Point> points;
+    std::ostringstream report;
+    report.precision(4);
+    for (const auto& base : baseline) {
+        if (inputKey != base.distribution + "/" + std::to_string(base.points)) {
+            inputKey = base.distribution + "/" + std::to_string(base.points);
+            points = generateBenchmarkPoints(base.distribution, base.points);
+        }
+        report << base.engine << " " << base.distribution << " " << base.points << ": ";
+        BenchmarkResult result;
+        int repetitions = options.repetitions > 0 ? options.repetitions : std::max(1, base.repetitions);
+        if (points.empty() ||
+            !measureBenchmark(base.engine, base.distribution, points, repetitions, options.scratchPrefix, result)) {
+            report << "FAILED to run\n";
+            ++regressions;
+            continue;
+        }
+        if (current) current->push_back(result);
+        double baseLow, baseHigh, low, high;
+        medianConfidenceInterval(base.samples, options.confidence, baseLow, baseHigh);
+        medianConfidenceInterval(result.samples, options.confidence, low, high);
+        double change = result.medianSeconds / std::max(base.medianSeconds, 1e-12) - 1.0;
+        report << base.medianSeconds << " s [" << baseLow << ", " << baseHigh << "] -> " << result.medianSeconds
+               << " s [" << low << ", " << high << "] (" << (change >= 0 ? "+" : "") << change * 100 << "%)";
+        if (change > options.threshold && low > baseHigh) {
+            report << " REGRESSION";
+            ++regressions;
+        } else if (change < -options.threshold && high < baseLow) {
+            report << " improved";
+            ++improvements;
+        }
+        if (result.triangles != base.triangles) {
+            report << " (triangles " << base.triangles << " -> " << result.triangles << ")";
+        }
+        if (!result.verified) {
+            report << " NOT VERIFIED";
+            ++regressions;
+        }
+        report << "\n";
+    }
+    std::cout << report.str() << baseline.size() << " measurements, " << regressions << " regressed, "
+              << improvements << " improved (threshold " << options.threshold * 100 << "%, "
+              << options.confidence * 100 << "% median intervals)." << std::endl;
+    return regressions == 0;
+}
+
+int main(int argc, char** argv) {
+    // Usage: delaunay [--tiles N | --shards N | --cache DIR] [--trace trace.json] [--perf] [--validate] [--memory]
+    //                 [--allow-reflex-hull] [--raster WxH raster.pgm|.raw] [--binary] [--compress]
+    //                 [points.xyz|.csv|.las|.ply|.bin] [output.vtk|.vtu|.mesh]
+    //        delaunay [--binary] --pipeline OUTPUT_DIR points...
+    //        delaunay --batch input.pack|manifest.txt output.pack [threads]
+    //        delaunay --serve SOCKET_PATH [workers]
+    //        delaunay --bench [output_prefix] [maxPoints] [repetitions]
+    //        delaunay --regress baseline.json [thresholdPercent] [repetitions] [current.json]
+    //        delaunay --stream points.bin output_prefix [maxPointsPerColumn]
+    if (argc > 1 && std::string(argv[1]) == "--stream") {
+        PointCloud cloud;
+        if (argc < 4 || !readPointsRaw(argv[2], cloud)) {
+            std::cerr << "Usage: " << argv[0] << " --stream points.bin output_prefix [maxPointsPerColumn]" << std::endl;
+            return 1;
+        }
+        StreamingOptions options;
+        if (argc > 4) options.maxPointsPerColumn = std::strtoull(argv[4], nullptr, 10);
+        StreamingStats stats;
+        auto start = std::chrono::high_resolution_clock::now();
+        if (!streamingDelaunayTriangulation(cloud.points(), argv[3], options, &stats)) return 1;
+        std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now() - start;
+        std::cout << "Time taken for streaming triangulation: " << duration.count() << " seconds." << std::endl;
+        std::cout << "Generated " << stats.triangles << " triangles over " << stats.columns
+                  << " columns (peak " << stats.peakActiveTriangles << " active)." << std::endl;
+        return 0;
+    }
+
+    if (argc > 1 && std::string(argv[1]) == "--bench") {
+        BenchmarkOptions options;
+        std::string prefix = argc > 2 ? argv[2] : "benchmark";
+        if (argc > 3) options.maxPoints = std::strtoull(argv[3], nullptr, 10);
+        if (argc > 4) options.repetitions = std::atoi(argv[4]);
+        options.scratchPrefix = prefix + "-stream";
+        std::vector<BenchmarkResult> results = runBenchmarks(options);
+        return writeBenchmarkJSON(prefix + ".json", results) && writeBenchmarkCSV(prefix + ".csv", results) ? 0 : 1;
+    }
+
+    if (argc > 2 && std::string(argv[1]) == "--regress") {
+        std::vector<BenchmarkResult> baseline, current;
+        if (!readBenchmarkJSON(argv[2], baseline)) return 2;
+        RegressionOptions options;
+        if (argc > 3) options.threshold = std::atof(argv[3]) / 100.0;
+        if (argc > 4) options.repetitions = std::atoi(argv[4]);
+        bool ok = checkBenchmarkRegressions(baseline, options, &current);
+        if (argc > 5 && !writeBenchmarkJSON(argv[5], current)) return 2;
+        return ok ? 0 : 1;
+    }
+
+#if defined(__unix__) || defined(__APPLE__)
+    if (argc > 2 && std::string(argv[1]) == "--serve") {
+        DaemonOptions options;
+        if (argc > 3) options.workers = std::atoi(argv[3]);
+        return runDaemon(argv[2], options) ? 0 : 1;
+    }
+#endif
+
+    // Options come first; the remaining arguments are the input and output files
+    int tiles = 0, shards = 0;
+    std::string cacheDirectory, pipelineDirectory, traceFile, rasterFile;
+    int rasterWidth = 0, rasterHeight = 0;
+    bool batch = false, perf = false, validate = false, allowReflexHull = false, memory = false;
+    ExportOptions exportOptions;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--tiles" && i + 1 < argc) {
+            tiles = std::atoi(argv[++i]);
+        } else if (arg == "--shards" && i + 1 < argc) {
+            shards = std::atoi(argv[++i]);
+        } else if (arg == "--cache" && i + 1 < argc) {
+            cacheDirectory = argv[++i];
+        } else if (arg == "--pipeline" && i + 1 < argc) {
+            pipelineDirectory = argv[++i];
+        } else if (arg == "--trace" && i + 1 < argc) {
+            traceFile = argv[++i];
+        } else if (arg == "--raster" && i + 2 < argc) {
+            if (std::sscanf(argv[++i], "%dx%d", &rasterWidth, &rasterHeight) != 2) {
+                std::cerr << "Error: --raster expects WIDTHxHEIGHT, got " << argv[i] << std::endl;
+                return 1;
+            }
+            rasterFile = argv[++i];
+        } else if (arg == "--memory") {
+            memory = true;
+        } else if (arg == "--binary") {
+            exportOptions.binary = true;
+        } else if (arg == "--compress") {
+            exportOptions.compress = true;
+        } else if (arg == "--validate") {
+            validate = true;
+        } else if (arg == "--allow-reflex-hull") {
+            allowReflexHull = true;
+        } else if (arg == "--perf") {
+            perf = true;
+        } else if (arg == "--batch") {
+            batch = true;
+        } else {
+            args.push_back(arg);
+        }
+    }
+
+    if (memory) enableMemoryAccounting();
+    if (!traceFile.empty()) {
+        startTracing();
+        setTraceThreadName("main");
+    }
+
+    if (batch) {
+        if (args.size() < 2) {
+            std::cerr << "Usage: " << argv[0] << " --batch input.pack|manifest.txt output.pack [threads]" << std::endl;
+            return 1;
+        }
+        BatchStats batchStats;
+        bool ok = runBatch(args[0], args[1], args.size() > 2 ? std::atoi(args[2].c_str()) : 0, &batchStats);
+        std::cout << "Triangulated " << batchStats.jobs << " jobs (" << batchStats.failed << " failed), "
+                  << batchStats.triangles << " triangles in " << batchStats.seconds << " seconds ("
+                  << batchStats.jobs / std::max(batchStats.seconds, 1e-9) << " jobs/second)." << std::endl;
+        if (!traceFile.empty() && !writeChromeTrace(traceFile)) return 1;
+        return ok ? 0 : 1;
+    }
+
+    if (!pipelineDirectory.empty()) {
+        PipelineOptions pipeline;
+        pipeline.outputDirectory = pipelineDirectory;
+        pipeline.exportOptions = exportOptions;
+        PipelineStats pipelineStats;
+        bool ok = runPipeline(args, pipeline, &pipelineStats);
+        std::cout << "Processed " << pipelineStats.files << " files (" << pipelineStats.failed << " failed), "
+                  << pipelineStats.points << " points, " << pipelineStats.triangles << " triangles in "
+                  << pipelineStats.seconds << " seconds." << std::endl;
+        if (!traceFile.empty() && !writeChromeTrace(traceFile)) return 1;
+        return ok ? 0 : 1;
+    }
+
+    std::unique_ptr<PerfCounters> perfCounters;
+    std::unique_ptr<PerfReport> perfReport;
+    if (perf) {
+        perfCounters.reset(new PerfCounters());
+        perfReport.reset(new PerfReport(*perfCounters));
+    }
+
+    PointCloud cloud;
+    if (!args.empty()) {
+        auto loadStart = std::chrono::high_resolution_clock::now();
+        if (!loadPointCloud(args[0], cloud)) return 1;
+        if (perfReport) perfReport->mark("load");
+        std::chrono::duration<double> loadTime = std::chrono::high_resolution_clock::now() - loadStart;
+        std::cout << "Loaded " << cloud.count << " points in " << loadTime.count() << " seconds." << std::endl;
+        if (cloud.count < 3) {
+            std::cerr << "Error: Need at least 3 points" << std::endl;
+            return 1;
+        }
+    }
+    std::string outputFile = args.size() > 1 ? args[1] : "triangulation.vtk";
+
+    std::vector<Point> points = {
+        {0.0, 0.0}, {0.7, 1.4}, {2.7, 2.7}, {6.0, 3.8},
+        {10.5, 4.8}, {16.1, 5.5}, {22.7, 5.9}, {29.9, 6.0},
+        {37.7, 5.9}, {45.9, 5.5}, {54.1, 5.0}, {62.3, 4.4},
+        {70.1, 3.6}, {77.3, 2.9}, {83.9, 2.1}, {89.5, 1.4},
+        {94.0, 0.8}, {97.3, 0.4}, {99.3, 0.1}, {0.7, -1.4},
+        {2.7, -2.7}, {6.0, -3.8}, {10.5, -4.8}, {16.1, -5.5},
+        {22.7, -5.9}, {29.9, -6.0}, {37.7, -5.9}, {45.9, -5.5},
+        {54.1, -5.0}, {62.3, -4.4}, {70.1, -3.6}, {77.3, -2.9},
+        {83.9, -2.1}, {89.5, -1.4}, {94.0, -0.8}, {97.3, -0.4},
+        {99.3, -0.1}, {0.7, 0.0}, {2.7, 0.0}, {6.0, 0.0},
+        {10.5, 0.0}, {16.1, 0.0}, {22.7, 0.0}, {29.9, 0.0},
+        {37.7, 0.0}, {45.9, 0.0}, {54.1, 0.0}, {62.3, 0.0},
+        {70.1, 0.0}, {77.3, 0.0}, {83.9, 0.0}, {89.5, 0.0},
+        {94.0, 0.0}, {97.3, 0.0}, {99.3, 0.0}, {100.0, 0.0}
+    };   
+    PointSpan input = !args.empty() ? cloud.points() : PointSpan(points);
+
+    if (perfReport) perfReport->begin();
+    auto start = std::chrono::high_resolution_clock::now();
+    TilingStats tilingStats;
+    std::vector<IndexedTriangle> triangles;
+    if (shards > 0) {
+        ShardingOptions sharding;
+        sharding.workers = shards;
+        triangles = shardedDelaunayTriangulation(input, sharding, &tilingStats);
+    } else if (tiles > 0) {
+        triangles = tiledDelaunayTriangulation(input, tiles, tiles, 0, &tilingStats);
+    } else if (!cacheDirectory.empty()) {
+        CacheOptions cacheOptions;
+        cacheOptions.directory = cacheDirectory;
+        TriangulationCache cache(cacheOptions);
+        bool hit = false;
+        triangles = cachedDelaunayTriangulation(input, cache, &hit);
+        std::cout << "Cache " << (hit ? "hit" : "miss") << " in " << cacheDirectory << std::endl;
+    } else {
+        triangles = delaunayTriangulationIndexed(input);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    if (perfReport) perfReport->mark("triangulate");
+    AccountedBytes outputBytes(memoryTriangles, capacityBytes(triangles));
+
+    std::chrono::duration<double> duration = end - start;
+    std::cout << "Time taken for triangulation: " << duration.count() << " seconds." << std::endl;
+    std::cout << "Generated " << triangles.size() << " triangles." << std::endl;
+#if defined(DELAUNAY_PROFILE)
+    collectTriangulationProfile().write(std::cout);
+#endif
+    if (tiles > 0 || shards > 0) {
+        std::cout << "Merged " << (shards > 0 ? "shards" : "tiles") << ": " << tilingStats.safeTriangles << " kept, "
+                  << tilingStats.seamTriangles << " seam triangles from " << tilingStats.bandPoints
+                  << " band points, merge " << (tilingStats.verified ? "verified" : "NOT verified") << "." << std::endl;
+        if (!tilingStats.verified) return 1;
+    }
+
+    // The mesh is already indexed, so points and cells are written directly
+    if (perfReport) perfReport->begin();
+    if (!exportMesh(input, triangles, cloud.attributes, outputFile, exportOptions)) return 1;
+    if (!rasterFile.empty() &&
+        !writeRaster(input, triangles, cloud.attributes, rasterWidth, rasterHeight, rasterFile)) {
+        return 1;
+    }
+    if (perfReport) {
+        perfReport->mark("export");
+        perfReport->write(std::cout, input.size());
+    }
+    if (!traceFile.empty() && !writeChromeTrace(traceFile)) return 1;
+
+    bool valid = true;
+    if (validate) {
+        auto validateStart = std::chrono::high_resolution_clock::now();
+        ValidationReport report = validateTriangulation(input, triangles);
+        report.allowReflexBoundary = allowReflexHull;
+        std::chrono::duration<double> validateTime = std::chrono::high_resolution_clock::now() - validateStart;
+        report.write(std::cout);
+        std::cout << "Validated in " << validateTime.count() << " seconds." << std::endl;
+        valid = report.valid();
+    }
+
+    // After validation, so its adjacency lists show up in the peaks
+    if (memory) MemoryLedger::instance().write(std::cout, input.size());
+
+    return valid ? 0 : 1;
+}
+